@@ -36,6 +36,7 @@ from ._jcustomizer import *
 # Customizers are applied in the order that they are defined currently.
 from . import _jmethod      # lgtm [py/import-own-module]
 from . import _jcollection  # lgtm [py/import-own-module]
+from ._jcollection import toPython, unbox
 from . import _jio          # lgtm [py/import-own-module]
 from . import protocol      # lgtm [py/import-own-module]
 from . import _jthread      # lgtm [py/import-own-module]
@@ -50,6 +51,7 @@ __all__.extend(_jpackage.__all__)
 __all__.extend(_jclass.__all__)
 __all__.extend(_jcustomizer.__all__)
 __all__.extend(_gui.__all__)
+__all__.extend(_jcollection.__all__)
 
 __version__ = "1.3.1_dev0"
 __version_info__ = __version__.split('.')
@@ -15,6 +15,7 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import os
 import sys
 import atexit
 import _jpype
@@ -124,6 +125,32 @@ def _handleClassPath(clsList):
     return _classpath._SEP.join(out)
 
 
+def _handleClassDataSharing(args, archive):
+    # Only classes defined by the builtin loaders can be shared, so the
+    # JPype jar must be on the system class path rather than loaded
+    # through our own class loader.  The class path must also agree
+    # between the run that created the archive and those that use it.
+    jar = os.path.join(os.path.dirname(_jpype.__file__), 'org.jpype.jar')
+    if os.path.exists(jar):
+        for i, arg in enumerate(args):
+            if arg.startswith('-Djava.class.path='):
+                rest = arg[len('-Djava.class.path='):]
+                if rest:
+                    jar = jar + _classpath._SEP + rest
+                args[i] = '-Djava.class.path=%s' % jar
+                break
+        else:
+            args.append('-Djava.class.path=%s' % jar)
+
+    if os.path.exists(archive):
+        args.append('-XX:SharedArchiveFile=%s' % archive)
+        # A stale archive is silently ignored unless the user asked otherwise
+        if not any(i.startswith('-Xshare:') for i in args):
+            args.append('-Xshare:auto')
+    else:
+        args.append('-XX:ArchiveClassesAtExit=%s' % archive)
+
+
 _JVM_started = False
 
 
@@ -163,6 +190,12 @@ def startJVM(*args, **kwargs):
         transfer control to Python rather than halting.  If
         not specified will be False if Python is started as
         an interactive shell.
+      cdsArchive (str): Path to a Java class data sharing archive.
+        If the archive exists it is mapped by the JVM at startup so
+        that JPype and the user classes are not loaded from cold bytecode.
+        If it does not exist, the classes loaded during this session
+        are recorded and written to the archive on shutdown.  Requires
+        Java 13 or later.  See ``jpype.cds.createArchive``.
 
     Raises:
       OSError: if the JVM cannot be started or is already running.
@@ -214,6 +247,11 @@ def startJVM(*args, **kwargs):
         else:
             raise TypeError("Unknown class path element")
 
+    # Class data sharing
+    cdsArchive = kwargs.pop('cdsArchive', None)
+    if cdsArchive:
+        _handleClassDataSharing(args, str(cdsArchive))
+
     ignoreUnrecognized = kwargs.pop('ignoreUnrecognized', False)
     convertStrings = kwargs.pop('convertStrings', False)
     interrupt = kwargs.pop('interrupt', not interactive())
@@ -21,9 +21,66 @@ from . import types as _jtypes
 from . import _jcustomizer
 from collections.abc import Mapping, Sequence, MutableSequence
 
+__all__ = ['toPython', 'unbox']
+
 JOverride = _jclass.JOverride
 
 
+def toPython(obj):
+    """ Convert nested Java collections to Python dicts and lists.
+
+    The whole structure is copied in one pass.  Maps become ``dict``,
+    other collections become ``list``, and strings, booleans and boxed
+    numbers become the matching Python scalars.  Any other Java object is
+    kept as is.
+
+    Args:
+        obj: a Java object to convert.
+
+    Returns:
+        A Python copy of the object.
+
+    Raises:
+        TypeError: if the object is not a Java object.
+        IllegalArgumentException: if the collection contains itself.
+    """
+    return _jpype.collectionToPython(obj)
+
+
+def unbox(obj, dtype=None, mask=False):
+    """ Unbox a Java collection or array of numbers into a Python buffer.
+
+    The numbers are unboxed on the Java side and copied to Python in a
+    single transfer, which is much faster than converting each element.
+    The result is a ``memoryview`` with format ``'q'`` for integers or
+    ``'d'`` for floats, which can be passed to ``numpy.asarray``.
+
+    Args:
+        obj: a Java collection or array holding ``java.lang.Number``.
+        dtype: ``int`` for 64 bit integers, ``float`` for doubles, or None
+          to use integers if every element is an integral box.
+        mask: if True, null elements are stored as zero and a second
+          memoryview with format ``'?'`` marks them.
+
+    Returns:
+        A memoryview of the values, or a tuple of the values and the mask.
+
+    Raises:
+        TypeError: if the object is not a Java object.
+        IllegalArgumentException: if an element is not a number, or is null
+          without a mask.
+    """
+    if dtype is None:
+        code = '\0'
+    elif dtype is int:
+        code = 'J'
+    elif dtype is float:
+        code = 'D'
+    else:
+        raise ValueError("dtype must be int, float, or None")
+    return _jpype.unboxNumbers(obj, code, mask)
+
+
 @_jcustomizer.JImplementationFor("java.lang.Iterable")
 class _JIterable(object):
     """ Customizer for ``java.util.Iterable``
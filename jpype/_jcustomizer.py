@@ -17,7 +17,7 @@
 # *****************************************************************************
 import _jpype
 
-__all__ = ['JImplementationFor', 'JConversion']
+__all__ = ['JImplementationFor', 'JConversion', 'JGILPolicy']
 
 # Member types that are copied from the prototype
 _jcopymembers = (str, property, staticmethod, classmethod)
@@ -123,6 +123,57 @@ def JImplementationFor(clsname, base=False):
     return customizer
 
 
+def JGILPolicy(policy, *names):
+    """ Decorator to set how methods of a class release the GIL.
+
+    Applies to a customizer prototype and must be listed below
+    ``@JImplementationFor`` so that it is applied first.  The policy is set
+    on the named Java methods of the class.  Derived classes only receive
+    the policy when the customizer is registered with ``base=True``.
+    Setting a policy restarts the adaptive timing of the method.
+
+    Policies are:
+
+      - "default": release the GIL, or keep it for methods found to be
+        short when adaptive release is enabled with
+        ``_jpype.setAdaptiveGIL``.
+      - "release": always release the GIL.
+      - "hold": never release the GIL.  Only use this for methods that
+        are short and can not block waiting on another thread, as
+        holding the GIL while blocked will deadlock Python threads.
+
+    Args:
+      policy (str): One of "default", "release" or "hold".
+      names (str): Names of the Java methods to apply the policy to.
+
+    Example:
+
+      .. code-block:: python
+
+          @JImplementationFor("java.util.BitSet")
+          @JGILPolicy("hold", "get", "set")
+          class _BitSetCustomizer(object):
+              pass
+
+    """
+    if policy not in ("default", "release", "hold"):
+        raise ValueError("unknown GIL policy '%s'" % policy)
+
+    def customizer(proto):
+        init = proto.__dict__.get('__jclass_init__', None)
+
+        def __jclass_init__(cls):
+            if init is not None:
+                init(cls)
+            for name in names:
+                method = cls.__dict__.get(name, None)
+                if isinstance(method, _jpype._JMethod):
+                    method._gilPolicy = policy
+        proto.__jclass_init__ = __jclass_init__
+        return proto
+    return customizer
+
+
 def _applyStickyMethods(cls, sticky):
     for method in sticky:
         attr = getattr(method, '__joverride__')
@@ -17,7 +17,7 @@
 # *****************************************************************************
 import _jpype
 
-__all__ = ['JObject']
+__all__ = ['JObject', 'getFields']
 
 
 class JObject(_jpype._JObject, internal=True):
@@ -59,6 +59,28 @@ class JObject(_jpype._JObject, internal=True):
         return _JObjectFactory(*args, **kwargs)
 
 
+def getFields(obj, *names):
+    """ Read several instance fields in a single call into Java.
+
+    Primitive fields are returned as plain ``bool``, ``int``, ``float`` or
+    ``str`` values rather than Java primitive wrappers.  Object fields are
+    converted as for attribute access.
+
+    Args:
+        obj: a Java object, or a sequence of Java objects.
+        *names: the names of the fields to read.
+
+    Returns:
+        A tuple of values for a single object, or a list of tuples with one
+        row per object for a sequence.
+
+    Raises:
+        AttributeError: if a name is not an instance field of the object.
+        TypeError: if an item is not a Java object.
+    """
+    return _jpype.readFields(obj, names)
+
+
 def _getDefaultJavaObject(obj):
     """ Determine the type of the object based the type of a value.
 
@@ -75,9 +75,12 @@ class _JThread(object):
         """ Detaches a thread from the JVM.
 
         This function detaches the thread and frees the associated resource in
-        the JVM. For codes making heavy use of threading this should be used
-        to prevent resource leaks. The thread can be reattached, so there
-        is no harm in detaching early or more than once. This method cannot fail
-        and there is no harm in calling it when the JVM is not running.
+        the JVM. Threads attached automatically are detached when they exit,
+        so this is only required for threads attached with ``attach()``. The
+        thread can be reattached, so there is no harm in detaching early or
+        more than once. If thread reuse is enabled with
+        ``_jpype.setThreadPolicy``, automatic attachments are kept until the
+        thread exits. This method cannot fail and there is no harm in calling
+        it when the JVM is not running.
         """
         return _jpype.detachThreadFromJVM()
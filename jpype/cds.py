@@ -0,0 +1,109 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+"""
+JPype Class Data Sharing Module
+-------------------------------
+
+Short lived programs built on JPype spend most of their time starting the
+JVM and loading the JPype runtime classes.  Java class data sharing (CDS)
+allows the loaded classes to be stored in an archive which is memory mapped
+on the next start.
+
+The archive is produced by starting the JVM once with the same arguments and
+class path that will be used later and recording the classes that are loaded.
+
+.. code-block:: python
+
+  import jpype
+  import jpype.cds
+
+  jpype.cds.createArchive("app.jsa", classpath=['lib/*'],
+        classes=['com.example.Main'])
+
+  # In the application
+  jpype.startJVM(classpath=['lib/*'], cdsArchive="app.jsa")
+
+Dynamic archives require Java 13 or later.
+"""
+import os as _os
+import subprocess as _subprocess
+import sys as _sys
+from . import _classpath
+
+__all__ = ['createArchive']
+
+_SCRIPT = """
+import ast, sys, jpype
+args, kwargs, classes, modules = ast.literal_eval(sys.stdin.read())
+jpype.startJVM(*args, **kwargs)
+for name in classes:
+    jpype.JClass(name)
+for name in modules:
+    __import__(name)
+"""
+
+
+def createArchive(archive, *args, classes=(), modules=(), **kwargs):
+    """ Create a class data sharing archive for use with ``startJVM``.
+
+    The JVM is started in a separate process with the supplied arguments,
+    the requested classes are loaded and the archive is written when the
+    JVM exits.  Any existing archive at the location is replaced.
+
+    Parameters:
+      archive (str): Path of the archive to create.
+      *args (str[]): Arguments to give to the JVM as in ``startJVM``.
+
+    Keyword Arguments:
+      classes (str[]): Java classes to load so that they are included
+        in the archive.
+      modules (str[]): Python modules to import after the JVM is
+        started.  This can be used to run a representative workload.
+      **kwargs: Additional keywords are passed to ``startJVM``.
+
+    Returns:
+      The absolute path to the archive.
+
+    Raises:
+      RuntimeError: if the archive could not be created.
+    """
+    archive = _os.path.abspath(str(archive))
+    if _os.path.exists(archive):
+        _os.remove(archive)
+
+    args = [str(i) for i in args]
+    if 'classpath' not in kwargs and not any(i.startswith('-Djava.class.path') for i in args):
+        kwargs['classpath'] = _classpath.getClassPath()
+    if 'jvmpath' in kwargs:
+        kwargs['jvmpath'] = str(kwargs['jvmpath'])
+    if isinstance(kwargs.get('classpath'), (list, tuple)):
+        kwargs['classpath'] = [str(i) for i in kwargs['classpath']]
+    kwargs['cdsArchive'] = archive
+    kwargs.setdefault('interrupt', False)
+
+    # The child must see the same modules as we do
+    env = dict(_os.environ)
+    env['PYTHONPATH'] = _os.pathsep.join([i for i in _sys.path if i])
+    data = repr((args, kwargs, list(classes), list(modules)))
+    proc = _subprocess.run([_sys.executable, '-c', _SCRIPT], input=data, env=env,
+                           stdout=_subprocess.PIPE, stderr=_subprocess.STDOUT,
+                           universal_newlines=True)
+    if proc.returncode != 0 or not _os.path.exists(archive):
+        raise RuntimeError("Unable to create class data sharing archive '%s':\n%s"
+                           % (archive, proc.stdout))
+    return archive
@@ -214,6 +214,19 @@ def _asPython(x):
     return x._py()
 
 
+def _convertDeferred(deferred):
+    # Date, time and decimal values are converted together in one call
+    if not deferred:
+        return
+    try:
+        values = _jpype.dataColumnToPython([v for _, _, v in deferred])
+    except TypeError as ex:
+        # Report failures as the per value conversion in _fetchRow would
+        raise _UnsupportedTypeError(str(ex)) from ex
+    for (row, idx, _), v in zip(deferred, values):
+        row[idx] = v
+
+
 # This maps the types reported by the columns to the type used for the getter
 # and converter
 _default_map = {ARRAY: OBJECT, OBJECT: OBJECT, NULL: OBJECT,
@@ -758,7 +771,7 @@ class Cursor(object):
         self._resultSetCount = meta.getColumnCount()
         self._columnTypes = None
 
-    def _fetchRow(self, converters):
+    def _fetchRow(self, converters, deferred=None):
         cx = self._connection
         count = self._resultSetCount
         meta = self._resultSetMeta
@@ -786,14 +799,17 @@ class Cursor(object):
                 value = tp.get(self._resultSet, idx + 1, False)
                 if value is None or converters is None:
                     row.append(value)
-                elif byPosition:
-                    # find the column converter by type
-                    converter = converters[idx]
-                    row.append(converter(value))
                 else:
                     # find the column converter by type
-                    converter = cx._converters.get(type(value), _nop)
-                    row.append(converter(value))
+                    if byPosition:
+                        converter = converters[idx]
+                    else:
+                        converter = cx._converters.get(type(value), _nop)
+                    if converter is _asPython and deferred is not None:
+                        deferred.append((row, idx, value))
+                        row.append(value)
+                    else:
+                        row.append(converter(value))
             return row
         except TypeError as ex:
             raise _UnsupportedTypeError(str(ex)) from ex
@@ -1189,13 +1205,15 @@ class Cursor(object):
         # Set a fetch size
         self._resultSet.setFetchSize(size)
         rows = []
+        deferred = []
         if types is not None:
             self._columnTypes = types
         for i in range(size):
             if not self._resultSet.next():
                 break
-            row = self._fetchRow(converters)
+            row = self._fetchRow(converters, deferred)
             rows.append(row)
+        _convertDeferred(deferred)
         # Restore the default fetch size
         self._resultSet.setFetchSize(0)
         return rows
@@ -1211,11 +1229,13 @@ class Cursor(object):
         self._check_executed()
         # Set a fetch size
         rows = []
+        deferred = []
         if types is not None:
             self._columnTypes = types
         while self._resultSet.next():
-            row = self._fetchRow(converters)
+            row = self._fetchRow(converters, deferred)
             rows.append(row)
+        _convertDeferred(deferred)
         return rows
 
     def __iter__(self):
@@ -17,7 +17,7 @@
 # *****************************************************************************
 import _jpype
 
-__all__ = ['convertToDirectBuffer']
+__all__ = ['convertToDirectBuffer', 'Arena']
 
 
 def convertToDirectBuffer(obj):
@@ -30,3 +30,32 @@ def convertToDirectBuffer(obj):
             "Memoryview must be writable for wrapping in a byte buffer")
 
     return _jpype.convertToDirectBuffer(memoryview_of_obj)
+
+
+class Arena(_jpype._JArena):
+    """ A region of native memory shared between Python and Java.
+
+    Converting many small Python buffers with ``convertToDirectBuffer``
+    requires tracking the lifespan of each buffer.  An arena maps one
+    page aligned region when created and hands out blocks of it as
+    direct ``java.nio.ByteBuffer`` slices.  Use ``memoryview`` on a block to
+    access it from Python.
+
+    Blocks are returned to the arena with ``release`` or in bulk by epoch.
+    ``advance`` starts a new epoch and ``reclaim(epoch)`` releases every
+    block allocated during that epoch or earlier.  The region itself is
+    freed once the arena is closed and Java no longer holds any block.
+
+    Args:
+        size (int): Number of bytes to reserve.  This is rounded up to a
+          whole number of pages.
+
+    Keyword Arguments:
+        hugepages (bool): Request huge pages for the region if the
+          operating system provides them.
+
+    Raises:
+        MemoryError: if the region cannot be mapped or no free block is
+          large enough for an allocation.
+    """
+    __slots__ = ()
@@ -47,6 +47,11 @@ Example:
     newobj = JUnpickler(fd).load()
 
 
+With pickle protocol 5 the serialized form of each Java object is passed as
+a ``pickle.PickleBuffer`` backed by a direct ``ByteBuffer``.  Supplying a
+``buffer_callback`` to ``JPickler`` transfers it out-of-band without a copy.
+The same buffers must be passed to ``JUnpickler`` with ``buffers``.
+
 Proxies and other JPype specific module resources cannot be pickled currently.
 
 Requires:
@@ -59,6 +64,11 @@ import pickle
 
 from copyreg import dispatch_table
 
+try:
+    from pickle import PickleBuffer as _PickleBuffer
+except ImportError:  # pragma: no cover
+    _PickleBuffer = None
+
 
 # TODO: Support use of a custom classloader with the unpickler.
 # TODO: Use copyreg to pickle a JProxy
@@ -81,10 +91,12 @@ class _JDispatch(object):
     class that can produce reducers as needed.
     """
 
-    def __init__(self, dispatch):
-        self._encoder = _jpype.JClass('org.jpype.pickle.Encoder')()
+    def __init__(self, dispatch, protocol=None, outofband=False):
+        self._encoder = _jpype.JClass('org.jpype.pickle.Encoder')(outofband)
         self._builder = JUnserializer()
         self._dispatch = dispatch
+        self._buffers = (protocol is not None and protocol >= 5
+                         and _PickleBuffer is not None)
 
         # Extension dispatch table holds reduce method
         self._call = self.reduce
@@ -104,8 +116,10 @@ class _JDispatch(object):
 
     # For Python3
     def reduce(self, obj):
-        byte = bytes(self._encoder.pack(obj))
-        return (self._builder, (byte, ))
+        buffer = self._encoder.pack(obj)
+        if self._buffers:
+            return (self._builder, (_PickleBuffer(buffer), ))
+        return (self._builder, (bytes(memoryview(buffer)), ))
 
 
 class JPickler(pickle.Pickler):
@@ -125,9 +139,28 @@ class JPickler(pickle.Pickler):
 
     def __init__(self, file, *args, **kwargs):
         pickle.Pickler.__init__(self, file, *args, **kwargs)
+        protocol = args[0] if args else kwargs.get('protocol')
+        if protocol is None:
+            protocol = pickle.DEFAULT_PROTOCOL
+        elif protocol < 0:
+            protocol = pickle.HIGHEST_PROTOCOL
+        outofband = kwargs.get('buffer_callback') is not None
 
         # In Python3 we need to hook into the dispatch table for extensions
-        self.dispatch_table = _JDispatch(dispatch_table)
+        self.dispatch_table = _JDispatch(dispatch_table, protocol, outofband)
+
+
+def _toBuffer(data):
+    """Get a Java view of pickled data without copying if possible."""
+    if isinstance(data, bytes) or _PickleBuffer is None:
+        return data
+    try:
+        view = _PickleBuffer(data).raw()
+    except BufferError:
+        return bytes(memoryview(data))
+    if view.readonly:
+        return bytes(view)
+    return _jpype.convertToDirectBuffer(view)
 
 
 class JUnpickler(pickle.Unpickler):
@@ -163,6 +196,6 @@ class JUnpickler(pickle.Unpickler):
 
             class JUnserializer(object):
                 def __call__(self, *args):
-                    return decoder.unpack(args[0])
+                    return decoder.unpack(_toBuffer(args[0]))
             return JUnserializer
         return pickle.Unpickler.find_class(self, module, cls)
@@ -75,6 +75,8 @@ def _JFileConvert(jcls, obj):
 @_jcustomizer.JConversion("java.lang.Iterable", instanceof=Sequence, excludes=str)
 @_jcustomizer.JConversion("java.util.Collection", instanceof=Sequence, excludes=str)
 def _JSequenceConvert(jcls, obj):
+    if isinstance(obj, (list, tuple)):
+        return _jpype.collectionToJava(obj)
     return _jclass.JClass('java.util.Arrays').asList(obj)
 
 
@@ -89,6 +91,8 @@ def _JSetConvert(jcls, obj):
 
 @_jcustomizer.JConversion("java.util.Map", instanceof=Mapping)
 def _JMapConvert(jcls, obj):
+    if isinstance(obj, dict):
+        return _jpype.collectionToJava(obj)
     hm = _jclass.JClass('java.util.HashMap')()
     for p, v in obj.items():
         hm[p] = v
@@ -121,28 +125,19 @@ if sys.version_info < (3, 6):  # pragma: no cover
 
 
 @_jcustomizer.JImplementationFor('java.sql.Date')
-class _JSQLDate:
-    def _py(self):
-        return datetime.date(self.getYear() + 1900, self.getMonth() + 1, self.getDate())
-
-
 @_jcustomizer.JImplementationFor('java.sql.Time')
-class _JSQLTime:
-    def _py(self):
-        return datetime.time(self.getHours(), self.getMinutes(), self.getSeconds())
-
-
 @_jcustomizer.JImplementationFor('java.sql.Timestamp')
-class _JDate:
-    def _py(self):
-        return datetime.datetime(self.getYear() + 1900, self.getMonth() + 1, self.getDate(),
-                                 self.getHours(), self.getMinutes(), self.getSeconds(), self.getNanos() // 1000)
-
-
 @_jcustomizer.JImplementationFor('java.math.BigDecimal')
-class _JBigDecimal:
+@_jcustomizer.JImplementationFor('java.time.LocalDate')
+@_jcustomizer.JImplementationFor('java.time.LocalTime')
+@_jcustomizer.JImplementationFor('java.time.LocalDateTime')
+@_jcustomizer.JImplementationFor('java.time.Instant')
+@_jcustomizer.JImplementationFor('java.time.OffsetDateTime')
+@_jcustomizer.JImplementationFor('java.time.ZonedDateTime')
+class _JDataType:
     def _py(self):
-        return decimal.Decimal(str(self))
+        # Extracts all fields in one call rather than calling each getter
+        return _jpype.dataToPython(self)
 
 
 @_jcustomizer.JConversion("java.sql.Time", instanceof=datetime.time)
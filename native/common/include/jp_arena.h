@@ -0,0 +1,140 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef _JPARENA_H_
+#define _JPARENA_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+/**
+ * A large region of native memory which is shared between Python and Java.
+ *
+ * The region is mapped once and exposed to Java as a single direct
+ * ByteBuffer.  Allocations are handed out as slices of that buffer, so
+ * only the parent buffer needs to be tracked by the reference queue.  The
+ * slices hold the parent alive, thus the memory is not unmapped until both
+ * the Python owner has closed the arena and Java has collected every slice.
+ *
+ * Blocks are returned to the arena either explicitly with release or in
+ * bulk with reclaim, which frees every block allocated during an epoch.
+ * Reusing a block that Java still holds is the caller's responsibility.
+ *
+ * The free lists are guarded by a lock as the arena may be used by several
+ * threads at once and is released by the reference queue thread.
+ */
+class JPArena
+{
+public:
+	JPArena(JPJavaFrame& frame, size_t size, bool hugePages);
+
+	/**
+	 * Allocate a block from the arena.
+	 *
+	 * @return a local reference to a direct ByteBuffer for the block.
+	 * @throws MemoryError if no free block is large enough.
+	 */
+	jobject allocate(JPJavaFrame& frame, size_t size);
+
+	/**
+	 * Return a block allocated by this arena.
+	 *
+	 * @throws ValueError if the buffer is not an allocated block.
+	 */
+	void release(JPJavaFrame& frame, jobject buffer);
+
+	/**
+	 * Start a new epoch.
+	 *
+	 * @return the number of the new epoch.
+	 */
+	size_t advance();
+
+	/**
+	 * Release every block allocated during the given epoch or earlier.
+	 *
+	 * @return the number of blocks released.
+	 */
+	size_t reclaim(size_t epoch);
+
+	/**
+	 * Drop the Python share of the arena.
+	 *
+	 * The memory is unmapped once Java releases the buffer.
+	 */
+	void close();
+
+	bool isClosed() const
+	{
+		return m_Closed;
+	}
+
+	size_t getSize() const
+	{
+		return m_Size;
+	}
+
+	size_t getUsed() const
+	{
+		return m_Used;
+	}
+
+	size_t getEpoch() const
+	{
+		return m_Epoch;
+	}
+
+	JPClass* getBufferClass() const
+	{
+		return m_SliceClass;
+	}
+
+	void setBufferClass(JPClass* cls)
+	{
+		m_SliceClass = cls;
+	}
+
+private:
+	~JPArena();
+	static void releaseHook(void* arena);
+	void freeBlock(size_t offset, size_t size);
+
+	struct Block
+	{
+		size_t m_Size;
+		size_t m_Epoch;
+	} ;
+
+	JPContext* m_Context;
+	char* m_Address;
+	size_t m_Size;
+	std::atomic<size_t> m_Used;
+	std::atomic<size_t> m_Epoch;
+	std::atomic<int> m_References;
+	std::atomic<bool> m_Closed;
+	jobject m_Buffer;
+	JPClass* m_SliceClass;
+	jmethodID m_Slice;
+	jmethodID m_Duplicate;
+	jmethodID m_Position;
+	jmethodID m_Limit;
+	std::map<size_t, size_t> m_Free;
+	std::map<size_t, Block> m_Blocks;
+	// Guards m_Buffer, m_Free and m_Blocks
+	std::mutex m_Lock;
+} ;
+
+#endif // _JPARENA_H_
@@ -34,8 +34,8 @@ public:
 	void *m_Memory;
 	Py_buffer m_Buffer;
 	int m_RefCount;
-	Py_ssize_t m_Shape[5];
-	Py_ssize_t m_Strides[5];
+	std::vector<Py_ssize_t> m_Shape;
+	std::vector<Py_ssize_t> m_Strides;
 	jboolean m_IsCopy;
 	jboolean m_Owned;
 } ;
@@ -77,6 +77,16 @@ public:
 		return m_Slice;
 	}
 
+	jsize      getStart() const
+	{
+		return m_Start;
+	}
+
+	jsize      getStep() const
+	{
+		return m_Step;
+	}
+
 	jarray     getJava()
 	{
 		return m_Object.get();
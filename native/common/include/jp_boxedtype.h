@@ -16,6 +16,8 @@
 #ifndef _JPBOXEDCLASS_H_
 #define _JPBOXEDCLASS_H_
 
+#include <atomic>
+
 // Boxed types have special conversion rules so that they can convert
 // from python primitives.  This code specializes the class wrappers
 // to make that happen.
@@ -46,13 +48,25 @@ public:
 		return m_PrimitiveType;
 	}
 
+	/**
+	 * Box a primitive value.
+	 *
+	 * This follows the semantics of valueOf.  Small values are held in
+	 * a cache of global references so that they do not need to call Java.
+	 *
+	 * @return a new local reference to the boxed object.
+	 */
 	jobject box(JPJavaFrame &frame, jvalue v);
 	virtual JPPyObject convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast) override;
 
 protected:
 	JPPrimitiveType* m_PrimitiveType;
+	std::vector<std::atomic<jobject> > m_Cache;
+	jlong            m_CacheLow;
+	jlong            m_CacheHigh;
 public:
 	jmethodID        m_CtorID;
+	jmethodID        m_ValueOfID;
 	jmethodID        m_DoubleValueID;
 	jmethodID        m_FloatValueID;
 	jmethodID        m_IntValueID;
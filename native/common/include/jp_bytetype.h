@@ -93,7 +93,7 @@ public:
 			void* memory, int offset) override;
 
 	virtual PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer &buffer, int subs, int base, jobject dims) override;
+			JPPyBuffer &buffer, int subs, int base) override;
 
 private:
 	static const jlong _Byte_Min = 127;
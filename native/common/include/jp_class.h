@@ -16,6 +16,7 @@
 #ifndef _JP_CLASS_H_
 #define _JP_CLASS_H_
 
+#include <atomic>
 #include "jp_modifier.h"
 
 class JPClass : public JPResource
@@ -31,11 +32,16 @@ public:
 			jint modifiers);
 	virtual ~JPClass();
 
-	void setHost(PyObject* host);
+	/**
+	 * Publish the Python wrapper for this class.
+	 *
+	 * @return false if another thread has already published a wrapper.
+	 */
+	bool setHost(PyObject* host);
 
 	PyTypeObject* getHost()
 	{
-		return (PyTypeObject*) m_Host.get();
+		return (PyTypeObject*) m_HostPtr.load(std::memory_order_acquire);
 	}
 
 	void setHints(PyObject* host);
@@ -187,6 +193,13 @@ public:
 	 */
 	virtual bool isAssignableFrom(JPJavaFrame& frame, JPClass* o);
 
+	/**
+	 * Check if this class is or inherits from another without calling Java.
+	 *
+	 * Uses the supertypes collected when the class was created.
+	 */
+	bool isSubTypeOf(JPClass* o) const;
+
 	// Object properties
 
 	JPClass* getSuperClass()
@@ -208,12 +221,14 @@ protected:
 	JPClassRef           m_Class;
 	JPClass*             m_SuperClass;
 	JPClassList          m_Interfaces;
+	JPClassList          m_SuperTypes;
 	JPMethodDispatch*    m_Constructors;
 	JPMethodDispatchList m_Methods;
 	JPFieldList          m_Fields;
 	string               m_CanonicalName;
 	jint                 m_Modifiers;
 	JPPyObject           m_Host;
+	std::atomic<PyObject*> m_HostPtr;
 	JPPyObject           m_Hints;
 } ;
 
@@ -16,6 +16,8 @@
 #ifndef JP_CLASSHINTS_H
 #define JP_CLASSHINTS_H
 
+#include <mutex>
+
 class JPConversion
 {
 public:
@@ -52,6 +54,8 @@ public:
 	virtual jvalue convert(JPMatch &match) override;
 } ;
 
+class JPHintConversion;
+
 class JPClassHints
 {
 public:
@@ -63,6 +67,11 @@ public:
 	 * Searches the list for a conversion. The first conversion better than
 	 * explicit is returned immediately.
 	 *
+	 * When the result depends only on the Python type of the object it is
+	 * memoized so that later searches are a single lookup.  Entries are
+	 * keyed on the version tag of the type so they are dropped when the type
+	 * is modified.  The memo is cleared whenever a conversion is added.
+	 *
 	 * @returns the quality of the match
 	 */
 	JPMatch::Type getConversion(JPMatch& match, JPClass *cls);
@@ -99,7 +108,20 @@ public:
 	void getInfo(JPClass *cls, JPConversionInfo &info);
 
 private:
-	std::list<JPConversion*> conversions;
+	void clearCache();
+
+	struct CacheEntry
+	{
+		JPPyObject type;
+		unsigned int version;
+		JPConversion *conversion;
+		JPMatch::Type quality;
+	} ;
+
+	std::list<JPHintConversion*> conversions;
+	std::map<PyTypeObject*, CacheEntry> m_Cache;
+	// Guards m_Cache, which is used by every conversion
+	std::mutex m_CacheLock;
 } ;
 
 extern JPConversion *hintsConversion;
@@ -0,0 +1,62 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef _JPCOLLECTIONS_H_
+#define _JPCOLLECTIONS_H_
+
+/**
+ * Deep conversion between Python containers and Java collections.
+ *
+ * The tree is encoded in a flat form that matches
+ * org.jpype.JPypeCollections so that the whole structure crosses JNI in a
+ * handful of bulk array transfers rather than one call per element.
+ */
+namespace JPCollections
+{
+
+/**
+ * Convert nested dicts, lists and tuples to HashMap and ArrayList.
+ *
+ * Exact str, bool, int and float values become String, Boolean, Long and
+ * Double.  Any other object uses the implicit conversion to Object.
+ *
+ * @return a local reference to the root.
+ * @throws TypeError if an element has no conversion to Object.
+ */
+jobject toJava(JPJavaFrame& frame, PyObject* obj);
+
+/**
+ * Convert nested Java maps and collections to dicts and lists.
+ *
+ * Strings, boxed numbers and booleans become Python scalars.  Other
+ * objects are returned as Java objects.
+ */
+JPPyObject toPython(JPJavaFrame& frame, jobject obj);
+
+/**
+ * Unbox a Java collection or array of numbers into Python memory.
+ *
+ * The values are unboxed in Java and copied in a single region transfer
+ * into a bytearray, returned as a memoryview with format 'q' or 'd'.
+ *
+ * @param type is 'J' for long, 'D' for double, or 0 to choose.
+ * @param mask is true to also return a '?' memoryview flagging nulls.
+ * @return the values, or a tuple of the values and the mask.
+ */
+JPPyObject unbox(JPJavaFrame& frame, jobject obj, char type, bool mask);
+
+}
+
+#endif // _JPCOLLECTIONS_H_
@@ -16,6 +16,7 @@
 #ifndef JP_CONTEXT_H
 #define JP_CONTEXT_H
 #include <jpype.h>
+#include <atomic>
 #include <list>
 
 /** JPClass is a bit heavy when we just need to hold a
@@ -133,6 +134,32 @@ public:
 	bool isThreadAttached();
 	void detachCurrentThread();
 
+	/**
+	 * Set how threads attached automatically by JPype are released.
+	 *
+	 * @param autoDetach detaches a thread from the JVM when it exits.
+	 * @param reuse keeps the attachment when detach is requested so that
+	 * pooled threads do not pay to reattach.  The thread is still detached
+	 * on exit.
+	 */
+	void setThreadPolicy(bool autoDetach, bool reuse);
+
+	bool getAutoDetach() const
+	{
+		return m_AutoDetach;
+	}
+
+	bool getReuseThreads() const
+	{
+		return m_ReuseThreads;
+	}
+
+	/** Get the threads currently attached and the total attaches and detaches. */
+	void getThreadCounts(long long *counts);
+
+	/** Called when a thread attached by JPype exits. */
+	void onThreadExit(bool automatic);
+
 	JNIEnv* getEnv();
 
 	JavaVM* getJavaVM()
@@ -230,9 +257,9 @@ private:
 	jmethodID m_Object_EqualsID;
 	jmethodID m_Object_HashCodeID;
 	jmethodID m_CallMethodID;
+	jmethodID m_Context_VectorizeID;
 	jmethodID m_Class_GetNameID;
 	jmethodID m_Context_collectRectangularID;
-	jmethodID m_Context_assembleID;
 	jmethodID m_String_ToCharArrayID;
 	jmethodID m_Context_CreateExceptionID;
 	jmethodID m_Context_GetExcClassID;
@@ -256,6 +283,12 @@ private:
 	jmethodID m_Package_GetObjectID;
 	jmethodID m_Package_GetContentsID;
 	jmethodID m_Context_NewWrapperID;
+	JPClassRef m_CollectionsClass;
+	jmethodID m_Collections_BuildID;
+	jmethodID m_Collections_FlattenID;
+	jmethodID m_Collections_UnboxID;
+	JPClassRef m_DataTypesClass;
+	jmethodID m_DataTypes_EncodeID;
 public:
 	jmethodID m_Context_GetStackFrameID;
 	void onShutdown();
@@ -264,6 +297,11 @@ private:
 	bool m_Running;
 	bool m_ConvertStrings;
 	bool m_Embedded;
+	bool m_AutoDetach;
+	bool m_ReuseThreads;
+	std::atomic<long long> m_ThreadsAttached;
+	std::atomic<long long> m_ThreadAttaches;
+	std::atomic<long long> m_ThreadDetaches;
 public:
 	JPGarbageCollection *m_GC;
 
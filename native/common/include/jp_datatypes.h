@@ -0,0 +1,43 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef _JPDATATYPES_H_
+#define _JPDATATYPES_H_
+
+/**
+ * Conversion of Java date, time and decimal values to Python.
+ *
+ * Values are reduced to a kind and two longs by org.jpype.JPypeDataTypes
+ * and rebuilt as datetime and Decimal objects with the CPython API.
+ * java.sql.Date, Time and Timestamp, java.time.LocalDate, LocalTime,
+ * LocalDateTime, Instant, OffsetDateTime, ZonedDateTime and
+ * java.math.BigDecimal are supported.  Other objects are returned
+ * unchanged.
+ */
+namespace JPDataTypes
+{
+
+JPPyObject toPython(JPJavaFrame& frame, jobject obj);
+
+/**
+ * Convert a sequence of Java objects with a single call to Java.
+ *
+ * @return a list of converted values.
+ */
+JPPyObject toPythonList(JPJavaFrame& frame, PyObject* seq);
+
+}
+
+#endif // _JPDATATYPES_H_
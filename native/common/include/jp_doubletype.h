@@ -90,7 +90,7 @@ public:
 			void* memory, int offset) override;
 
 	virtual PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer& view, int subs, int base, jobject dims) override;
+			JPPyBuffer& view, int subs, int base) override;
 } ;
 
 #endif // _JP_DOUBLE_TYPE_H_
\ No newline at end of file
@@ -53,11 +53,19 @@ public:
 		return m_Name;
 	}
 
-	JPPyObject getStaticField();
-	void     setStaticField(PyObject *pyobj);
+	JPPyObject getStaticField(JPJavaFrame& frame);
+	void     setStaticField(JPJavaFrame& frame, PyObject *pyobj);
 
-	JPPyObject getField(jobject inst);
-	void     setField(jobject inst, PyObject *pyobj);
+	JPPyObject getField(JPJavaFrame& frame, jobject inst);
+	void     setField(JPJavaFrame& frame, jobject inst, PyObject *pyobj);
+
+	/**
+	 * Read an instance field as a plain Python value.
+	 *
+	 * Primitives are returned as bool, int, float or str rather than the
+	 * Java primitive wrappers.  Objects convert as for getField.
+	 */
+	JPPyObject getPlainField(JPJavaFrame& frame, jobject inst);
 
 	bool isFinal() const
 	{
@@ -69,6 +77,12 @@ public:
 		return JPModifier::isStatic(m_Modifiers);
 	}
 
+	/** Type code for primitive fields, or 0 for objects. */
+	char getTypeCode() const
+	{
+		return m_TypeCode;
+	}
+
 	JPClass *getClass() const
 	{
 		return m_Class;
@@ -84,6 +98,7 @@ private:
 	jfieldID         m_FieldID;
 	JPClass*         m_Type;
 	jint             m_Modifiers;
+	char             m_TypeCode;
 } ;
 
 #endif // _JPFIELD_H_
\ No newline at end of file
@@ -16,6 +16,8 @@
 #ifndef JP_FUNCTIONAL_H
 #define JP_FUNCTIONAL_H
 
+#include <mutex>
+
 class JPFunctional : public JPClass
 {
 public:
@@ -34,8 +36,25 @@ public:
 	{
 		return m_Method;
 	}
+
+	/**
+	 * Find the live proxy for a callable converted to this interface.
+	 *
+	 * Entries are borrowed and removed when the proxy is deallocated, which
+	 * happens once Java releases the proxy instance.  Thus the cache never
+	 * extends the lifetime of the callable.  The instance is fetched under
+	 * the cache lock so the proxy cannot be released meanwhile.
+	 *
+	 * @return a local reference to the Java instance or NULL if there is none.
+	 */
+	jobject findProxy(JPJavaFrame& frame, PyObject *callable);
+	void addProxy(PyObject *callable, PyJPProxy *proxy);
+	void removeProxy(PyObject *callable, PyJPProxy *proxy);
+
 protected:
 	string  m_Method;
+	std::map<PyObject*, PyJPProxy*> m_Proxies;
+	std::mutex m_ProxiesLock;
 } ;
 
 #endif /* JP_FUNCTIONAL_H */
\ No newline at end of file
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #ifndef JP_GC_H
 #define JP_GC_H
+#include <atomic>
+#include <mutex>
 
 struct JPGCStats
 {
@@ -50,23 +52,29 @@ public:
 	void getStats(JPGCStats& stats);
 
 private:
+	/** Update the working size history and decide if Java should collect. */
+	bool decide();
+
 	JPContext *m_Context;
 	bool running;
-	bool in_python_gc;
-	bool java_triggered;
+	// Java triggers arrive on the reference queue thread without the GIL
+	std::atomic<bool> in_python_gc;
+	std::atomic<bool> java_triggered;
 	PyObject *python_gc;
 	jclass _SystemClass;
 	jmethodID _gcMethodID;
 
+	// Guards the working size history
+	std::mutex lock;
 	size_t last_python;
 	size_t last_java;
 	size_t low_water;
 	size_t high_water;
 	size_t limit;
 	size_t last;
-	int java_count;
-	int python_count;
-	int python_triggered;
+	std::atomic<int> java_count;
+	std::atomic<int> python_count;
+	std::atomic<int> python_triggered;
 } ;
 
 #endif /* JP_GC_H */
\ No newline at end of file
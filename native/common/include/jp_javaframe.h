@@ -171,7 +171,10 @@ public:
 	bool equals(jobject o1, jobject o2);
 	jint hashCode(jobject o);
 	jobject collectRectangular(jarray obj);
-	jobject assemble(jobject dims, jobject parts);
+	jobject buildCollection(jbyteArray codes, jlongArray longs, jdoubleArray doubles, jobjectArray objects);
+	jobjectArray flattenCollection(jobject obj);
+	jobjectArray unboxCollection(jobject obj, jchar type, jboolean mask);
+	jobjectArray encodeDataTypes(jobjectArray values);
 
 	jobject newArrayInstance(jclass c, jintArray dims);
 	jthrowable getCause(jthrowable th);
@@ -187,6 +190,9 @@ public:
 	 */
 	jstring fromStringUTF8(const string& str);
 	jobject callMethod(jobject method, jobject obj, jobject args);
+
+	/** Apply a static method elementwise over an array of primitive arrays. */
+	jobject vectorize(jobject method, jobject args, jint n, jboolean parallel);
 	jobject toCharArray(jstring jstr);
 	string getFunctional(jclass c);
 
@@ -15,13 +15,34 @@
  *****************************************************************************/
 #ifndef _JPMETHOD_H_
 #define _JPMETHOD_H_
+#include <atomic>
 #include "jp_modifier.h"
 class JPMethod;
 
+/** Enables adaptive GIL release for methods without an explicit policy. */
+extern std::atomic<int> _jp_gil_adaptive;
+
+/** Calls shorter than this many nanoseconds are candidates to keep the GIL. */
+extern std::atomic<long long> _jp_gil_threshold;
+
 class JPMethod : public JPResource
 {
 	friend class JPMethodDispatch;
 public:
+
+	/**
+	 * Controls whether the GIL is released while the method runs.
+	 *
+	 * The default follows the global adaptive setting.  Release and hold
+	 * force the behavior regardless of timing.
+	 */
+	enum GILPolicy
+	{
+		_gilDefault = 0,
+		_gilRelease = 1,
+		_gilHold = 2
+	} ;
+
 	JPMethod();
 	JPMethod(JPJavaFrame& frame,
 			JPClass* claz,
@@ -50,6 +71,22 @@ public:
 	JPMatch::Type matches(JPJavaFrame &frame, JPMethodMatch& match, bool isInstance, JPPyObjectVector& args);
 	JPPyObject invoke(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
 	JPPyObject invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
+
+	/** Invoke this overload directly without overload resolution.
+	 *
+	 * Each argument is converted to the fixed parameter type.  A TypeError
+	 * is raised if any argument does not convert implicitly.
+	 */
+	JPPyObject invokeBound(JPJavaFrame &frame, JPPyObjectVector& arg, bool instance);
+
+	/** Apply this static overload elementwise over the arguments.
+	 *
+	 * Each argument is transferred once to a Java primitive array and the
+	 * loop runs in Java.  Arguments of length one are broadcast.
+	 *
+	 * @return a Java primitive array holding the results.
+	 */
+	JPPyObject invokeVectorized(JPJavaFrame &frame, JPPyObjectVector& arg, bool parallel);
 	JPValue invokeConstructor(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg);
 
 	bool isAbstract() const
@@ -97,9 +134,41 @@ public:
 		return m_Method.get();
 	}
 
+	JPClass* getClass()
+	{
+		return m_Class;
+	}
+
+	/** Get the parameter types, including the instance for member methods. */
+	const JPClassList& getParameterTypes()
+	{
+		ensureTypeCache();
+		return m_ParameterTypes;
+	}
+
+	int getGILPolicy() const
+	{
+		return m_GILPolicy;
+	}
+
+	void setGILPolicy(int policy)
+	{
+		m_GILPolicy = policy;
+		m_GILSamples = 0;
+		m_GILShort = false;
+	}
+
+	/** True if adaptive timing has found this method to be short. */
+	bool isGILShort() const
+	{
+		return m_GILShort;
+	}
+
 private:
 	void packArgs(JPJavaFrame &frame, JPMethodMatch &match, vector<jvalue> &v, JPPyObjectVector &arg);
 	void ensureTypeCache();
+	bool holdGIL() const;
+	void recordGIL(long long elapsed);
 
 	JPMethod(const JPMethod& o);
 	JPMethod& operator=(const JPMethod&) ;
@@ -113,6 +182,10 @@ private:
 	JPClassList              m_ParameterTypes;
 	JPMethodList             m_MoreSpecificOverloads;
 	jint                     m_Modifiers;
+	std::atomic<int>         m_GILPolicy;
+	std::atomic<int>         m_GILSamples;
+	std::atomic<bool>        m_GILShort;
+	std::atomic<bool>        m_TypeCacheReady;
 } ;
 
 #endif // _JPMETHODOVERLOAD_H_
\ No newline at end of file
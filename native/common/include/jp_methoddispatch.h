@@ -16,6 +16,7 @@
 #ifndef _JPMETHODDISPATCH_H_
 #define _JPMETHODDISPATCH_H_
 
+#include <atomic>
 #include "jp_class.h"
 
 class JPMethodDispatch : public JPResource
@@ -76,6 +77,24 @@ public:
 		return m_Overloads;
 	}
 
+	/** Number of calls recorded while statistics are enabled. */
+	long long getCallCount() const
+	{
+		return m_CallCount;
+	}
+
+	/** Number of calls that missed the overload cache. */
+	long long getMissCount() const
+	{
+		return m_MissCount;
+	}
+
+	void resetStats()
+	{
+		m_CallCount = 0;
+		m_MissCount = 0;
+	}
+
 private:
 	/** Search for a matching overload.
 	 *
@@ -85,11 +104,22 @@ private:
 	bool findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch, JPPyObjectVector& vargs, bool searchInstance, bool raise);
 	void dumpOverloads();
 
+	/** Read the last resolution, false if it is being replaced. */
+	bool getLastCache(JPMethodCache &cache) const;
+	void setLastCache(const JPMethodCache &cache);
+
 	JPClass*      m_Class;
 	string        m_Name;
 	JPMethodList  m_Overloads;
 	jlong         m_Modifiers;
-	JPMethodCache m_LastCache;
+
+	// The last resolution is published under a sequence lock so that
+	// concurrent callers never pair a hash with another overload.
+	std::atomic<unsigned>  m_CacheSequence;
+	std::atomic<long>      m_CacheHash;
+	std::atomic<JPMethod*> m_CacheOverload;
+	std::atomic<long long> m_CallCount;
+	std::atomic<long long> m_MissCount;
 } ;
 
 #endif // _JPMETHODDISPATCH_H_
\ No newline at end of file
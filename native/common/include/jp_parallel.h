@@ -0,0 +1,82 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef _JPPARALLEL_H_
+#define _JPPARALLEL_H_
+
+#include <functional>
+
+/**
+ * Splitting of large array transfers across native workers.
+ *
+ * Transfers above the threshold divide the elements into contiguous slabs,
+ * one per worker.  Workers only touch memory that was pinned by the calling
+ * thread, so they never call JNI or Python.
+ *
+ * The caller must release the GIL before copying and only reacquire it once
+ * every critical region is released.  Waiting on the GIL while pinned would
+ * deadlock against a thread that holds the GIL and waits for the collector.
+ */
+namespace JPParallel
+{
+
+/**
+ * Set the transfer policy.
+ *
+ * @param threshold is the size in bytes above which transfers are split.
+ * @param workers is the number of workers to use, 0 for one per core, or 1
+ * to disable splitting.
+ */
+void setPolicy(Py_ssize_t threshold, int workers);
+
+Py_ssize_t getThreshold();
+
+int getWorkers();
+
+/**
+ * Get the number of workers that should be used for a transfer.
+ *
+ * @param bytes is the size of the transfer.
+ * @return the number of slabs, or 1 if the transfer should not be split.
+ */
+int plan(Py_ssize_t bytes);
+
+/**
+ * Get the number of rows to pin at a time when copying many small arrays.
+ *
+ * This bounds both the memory pinned and the local references held.
+ *
+ * @param rowBytes is the size of each row.
+ * @param workers is the number of slabs as returned by plan.
+ * @return the rows per batch, at least workers.
+ */
+Py_ssize_t batch(Py_ssize_t rowBytes, int workers);
+
+/**
+ * Call a function on contiguous slabs of [0, n).
+ *
+ * The GIL should be released by the caller around the whole pin, copy and
+ * unpin sequence.  The function must not throw or call JNI or Python.
+ *
+ * @param n is the number of elements.
+ * @param workers is the number of slabs as returned by plan.
+ * @param fn is called with the first and last (exclusive) element of a slab.
+ */
+void forEach(Py_ssize_t n, int workers,
+		const std::function<void(Py_ssize_t, Py_ssize_t)>& fn);
+
+}
+
+#endif // _JPPARALLEL_H_
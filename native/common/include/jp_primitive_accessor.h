@@ -19,6 +19,7 @@
 #include "jp_exception.h"
 #include "jp_javaframe.h"
 #include "jp_match.h"
+#include "jp_parallel.h"
 
 template <typename array_t, typename ptr_t>
 class JPPrimitiveArrayAccessor
@@ -85,15 +86,177 @@ public:
 
 } ;
 
+/**
+ * Copy a one dimensional buffer into a range of a primitive array.
+ *
+ * The array is pinned for the duration of the copy.  Large transfers
+ * release the GIL and are converted by several workers.
+ */
+template <class base_t>
+void setArrayFromBuffer(JPJavaFrame& frame, jarray a,
+		jsize start, jsize length, jsize step,
+		JPPyBuffer& buffer, const char* code)
+{
+	typedef typename base_t::type_t type_t;
+	Py_buffer& view = buffer.getView();
+	if (view.ndim != 1)
+		JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
+	Py_ssize_t vshape = view.shape[0];
+	Py_ssize_t vstep = view.strides[0];
+	if (vshape != length)
+		JP_RAISE(PyExc_ValueError, "mismatched size");
+
+	char* memory = (char*) view.buf;
+	if (view.suboffsets && view.suboffsets[0] >= 0)
+		memory = *((char**) memory) + view.suboffsets[0];
+	jconverter conv = getConverter(view.format, (int) view.itemsize, code);
+	if (conv == NULL)
+		JP_RAISE(PyExc_TypeError, "No type converter found");
+	jbulkconverter bulk = NULL;
+	if (step == 1 && vstep == view.itemsize)
+		bulk = getBulkConverter(view.format, (int) view.itemsize, code);
+	int workers = JPParallel::plan(length * (Py_ssize_t) sizeof (type_t));
+
+	jboolean isCopy;
+	type_t* val = (type_t*) frame.getEnv()->GetPrimitiveArrayCritical(a, &isCopy);
+	JP_TRACE_JAVA("GetPrimitiveArrayCritical", val);
+	if (val == NULL)
+		JP_RAISE(PyExc_MemoryError, "Unable to access array");  // GCOVR_EXCL_LINE
+	auto copy = [ = ](Py_ssize_t first, Py_ssize_t last)
+	{
+		char* src = memory + first * vstep;
+		type_t* dest = val + start + first * step;
+		if (bulk != NULL)
+		{
+			bulk(dest, src, (jsize) (last - first));
+			return;
+		}
+		for (Py_ssize_t i = first; i < last; ++i)
+		{
+			jvalue r = conv(src);
+			*dest = base_t::field(r);
+			src += vstep;
+			dest += step;
+		}
+	};
+	if (workers > 1)
+	{
+		// The GIL must not be reacquired until the array is released
+		JPPyCallRelease release;
+		JPParallel::forEach(length, workers, copy);
+		frame.getEnv()->ReleasePrimitiveArrayCritical(a, val, 0);
+		return;
+	}
+	copy(0, length);
+	JP_TRACE_JAVA("ReleasePrimitiveArrayCritical", val);
+	frame.getEnv()->ReleasePrimitiveArrayCritical(a, val, 0);
+}
+
+/**
+ * Builds the outer levels of a multidimensional primitive array.
+ *
+ * Each level is created with its own component type so that the rows can be
+ * stored directly in their parent as they are filled.  The parent of the
+ * current row is kept until the rows move on to the next parent.
+ */
+class JPArrayAssembler
+{
+public:
+
+	JPArrayAssembler(JPJavaFrame &frame, char code, Py_buffer &view)
+	: m_Frame(frame), m_View(view), m_Top(NULL), m_Holder(NULL), m_HolderIndex(-1)
+	{
+		// A single row is the result
+		if (view.ndim < 2)
+			return;
+		for (int j = 0; j < view.ndim - 1; ++j)
+			m_Classes.push_back(frame.FindClass(string(view.ndim - 1 - j, '[') + code));
+		m_Top = create(0);
+	}
+
+	/** Store row r counting in C order over all but the last dimension. */
+	void set(Py_ssize_t r, jarray row)
+	{
+		if (m_View.ndim < 2)
+		{
+			m_Top = m_Frame.NewLocalRef(row);
+			return;
+		}
+		int u = m_View.ndim - 1;
+		Py_ssize_t inner = m_View.shape[u - 1];
+		Py_ssize_t h = r / inner;
+		if (h != m_HolderIndex)
+		{
+			if (m_Holder != NULL && m_Holder != m_Top)
+				m_Frame.DeleteLocalRef(m_Holder);
+
+			// Walk down from the top to the array holding this row
+			std::vector<jsize> index(u - 1);
+			Py_ssize_t q = h;
+			for (int j = u - 2; j >= 0; --j)
+			{
+				index[j] = (jsize) (q % m_View.shape[j]);
+				q /= m_View.shape[j];
+			}
+			jobject obj = m_Top;
+			for (int j = 0; j < u - 1; ++j)
+			{
+				jobject next = m_Frame.GetObjectArrayElement((jobjectArray) obj, index[j]);
+				if (obj != m_Top)
+					m_Frame.DeleteLocalRef(obj);
+				obj = next;
+			}
+			m_Holder = obj;
+			m_HolderIndex = h;
+		}
+		m_Frame.SetObjectArrayElement((jobjectArray) m_Holder, (jsize) (r % inner), row);
+	}
+
+	/** Convert the assembled array to Python. */
+	PyObject *toPython()
+	{
+		JPClass *type = m_Frame.getContext()->_java_lang_Object;
+		if (m_Top != NULL)
+			type = m_Frame.findClassForObject(m_Top);
+		jvalue v;
+		v.l = m_Top;
+		return type->convertToPythonObject(m_Frame, v, false).keep();
+	}
+
+private:
+
+	jobject create(int level)
+	{
+		jsize len = (jsize) m_View.shape[level];
+		jobjectArray a = m_Frame.NewObjectArray(len, m_Classes[level], NULL);
+		if (level + 2 < m_View.ndim)
+		{
+			for (jsize i = 0; i < len; ++i)
+			{
+				jobject child = create(level + 1);
+				m_Frame.SetObjectArrayElement(a, i, child);
+				m_Frame.DeleteLocalRef(child);
+			}
+		}
+		return a;
+	}
+
+	JPJavaFrame &m_Frame;
+	Py_buffer &m_View;
+	std::vector<jclass> m_Classes;
+	jobject m_Top;
+	jobject m_Holder;
+	Py_ssize_t m_HolderIndex;
+} ;
+
 template <class type_t> PyObject *convertMultiArray(
 		JPJavaFrame &frame,
 		JPPrimitiveType* cls,
 		void (*pack)(type_t*, jvalue),
 		const char* code,
 		JPPyBuffer &buffer,
-		int subs, int base, jobject dims)
+		int subs, int base)
 {
-	JPContext *context = frame.getContext();
 	Py_buffer& view = buffer.getView();
 	jconverter converter = getConverter(view.format, (int) view.itemsize, code);
 	if (converter == NULL)
@@ -102,23 +265,87 @@ template <class type_t> PyObject *convertMultiArray(
 		return NULL;
 	}
 
-	// Reserve space for array.
-	jobjectArray contents = (jobjectArray) context->_java_lang_Object->newArrayOf(frame, subs);
+	// Create the outer levels of the array.
+	JPArrayAssembler assembler(frame, cls->getTypeCode(), view);
+	if (subs == 0)
+		return assembler.toPython();
 	std::vector<Py_ssize_t> indices(view.ndim);
 	int u = view.ndim - 1;
 	int k = 0;
-	jarray a0 = cls->newArrayOf(frame, base);
-	frame.SetObjectArrayElement(contents, k++, a0);
-	jboolean isCopy;
-	void *mem = frame.getEnv()->GetPrimitiveArrayCritical(a0, &isCopy);
-	JP_TRACE_JAVA("GetPrimitiveArrayCritical", mem);
-	type_t *dest = (type_t*) mem;
 
 	Py_ssize_t step;
 	if (view.strides == NULL)
 		step = view.itemsize;
 	else
 		step = view.strides[u];
+	jbulkconverter bulk = NULL;
+	if (step == view.itemsize)
+		bulk = getBulkConverter(view.format, (int) view.itemsize, code);
+
+	int workers = JPParallel::plan((Py_ssize_t) subs * base * (Py_ssize_t) sizeof (type_t));
+	if (workers > 1 && subs >= workers)
+	{
+		// Fill batches of rows in parallel.  Each batch is allocated before
+		// any row is pinned as no JNI calls are allowed while pinned.
+		Py_ssize_t batch = JPParallel::batch(base * (Py_ssize_t) sizeof (type_t), workers);
+		frame.getEnv()->EnsureLocalCapacity((jint) batch);
+		std::vector<jarray> rows;
+		std::vector<type_t*> mem;
+		for (Py_ssize_t r0 = 0; r0 < subs; r0 += batch)
+		{
+			Py_ssize_t r1 = (r0 + batch < subs) ? r0 + batch : subs;
+			rows.clear();
+			mem.clear();
+			for (Py_ssize_t r = r0; r < r1; ++r)
+			{
+				jarray a0 = cls->newArrayOf(frame, base);
+				assembler.set(r, a0);
+				rows.push_back(a0);
+			}
+			{
+				// The GIL must not be reacquired until every row is released
+				JPPyCallRelease release;
+				jboolean isCopy;
+				for (size_t r = 0; r < rows.size(); ++r)
+					mem.push_back((type_t*) frame.getEnv()->GetPrimitiveArrayCritical(rows[r], &isCopy));
+				JPParallel::forEach(r1 - r0, workers, [&](Py_ssize_t first, Py_ssize_t last)
+				{
+					std::vector<Py_ssize_t> index(view.ndim);
+					for (Py_ssize_t r = first; r < last; ++r)
+					{
+						Py_ssize_t q = r0 + r;
+						for (int j = u - 1; j >= 0; --j)
+						{
+							index[j] = q % view.shape[j];
+							q /= view.shape[j];
+						}
+						index[u] = 0;
+						char *src = buffer.getBufferPtr(index);
+						type_t *dest = mem[r];
+						if (bulk != NULL)
+						{
+							bulk(dest, src, base);
+							continue;
+						}
+						for (int i = 0; i < base; ++i, src += step)
+							pack(dest + i, converter(src));
+					}
+				});
+				for (size_t r = rows.size(); r > 0; --r)
+					frame.getEnv()->ReleasePrimitiveArrayCritical(rows[r - 1], mem[r - 1], 0);
+			}
+			for (size_t r = 0; r < rows.size(); ++r)
+				frame.DeleteLocalRef(rows[r]);
+		}
+		return assembler.toPython();
+	}
+
+	jarray a0 = cls->newArrayOf(frame, base);
+	assembler.set(k++, a0);
+	jboolean isCopy;
+	void *mem = frame.getEnv()->GetPrimitiveArrayCritical(a0, &isCopy);
+	JP_TRACE_JAVA("GetPrimitiveArrayCritical", mem);
+	type_t *dest = (type_t*) mem;
 
 	// Align with the first element in the array
 	char *src = buffer.getBufferPtr(indices);
@@ -147,28 +374,26 @@ template <class type_t> PyObject *convertMultiArray(
 				break;
 
 			a0 = cls->newArrayOf(frame, base);
-			frame.SetObjectArrayElement(contents, k++, a0);
+			assembler.set(k++, a0);
 			mem = frame.getEnv()->GetPrimitiveArrayCritical(a0, &isCopy);
 			JP_TRACE_JAVA("GetPrimitiveArrayCritical", mem);
 			dest = (type_t*) mem;
 			src = buffer.getBufferPtr(indices);
 		}
+		if (bulk != NULL && indices[u] == 0)
+		{
+			// Transfer the whole row at once
+			bulk(dest, src, base);
+			indices[u] = base;
+			continue;
+		}
 		pack(dest, converter(src));
 		src += step;
 		dest++;
 		indices[u]++;
 	}
 
-	// Assemble it into a multidimensional array
-	jobject out = frame.assemble(dims, contents);
-
-	// Convert it to Python
-	JPClass *type = context->_java_lang_Object;
-	if (out != NULL)
-		type = frame.findClassForObject(out);
-	jvalue v;
-	v.l = out;
-	return type->convertToPythonObject(frame, v, false).keep();
+	return assembler.toPython();
 }
 
 template <typename base_t>
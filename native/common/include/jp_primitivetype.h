@@ -47,7 +47,7 @@ public:
 			void* memory, int offset) = 0;
 
 	virtual PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer& view, int subs, int base, jobject dims) = 0;
+			JPPyBuffer& view, int subs, int base) = 0;
 
 	// Helper for Long types
 	PyObject *convertLong(PyTypeObject* wrapper, PyLongObject* tmp);
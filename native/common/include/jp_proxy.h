@@ -34,6 +34,16 @@ public:
 
 	jvalue getProxy();
 
+	/**
+	 * Get the Java instance only if it is still alive.
+	 *
+	 * Unlike getProxy this never creates an instance or touches Python, so
+	 * it can be used while another thread may be releasing the proxy.
+	 *
+	 * @return a local reference or NULL.
+	 */
+	jobject findInstance(JPJavaFrame& frame);
+
 	JPContext* getContext()
 	{
 		return m_Context;
@@ -72,8 +82,17 @@ public:
 	JPProxyFunctional(JPContext* context, PyJPProxy* inst, JPClassList& intf);
 	virtual ~JPProxyFunctional();
 	virtual JPPyObject getCallable(const string& cname) override;
+
+	/** Register this proxy to be reused when the callable is converted again. */
+	void addToCache(PyObject *callable);
+
+	/** Remove this proxy from the reuse cache. */
+	void removeFromCache();
+
 private:
 	JPFunctional *m_Functional;
+	// The callable this proxy was registered under, held as a key only
+	PyObject *m_Key;
 } ;
 
 /** Special wrapper for round trip returns
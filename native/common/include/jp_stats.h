@@ -0,0 +1,95 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef JP_STATS_H
+#define JP_STATS_H
+
+/**
+ * Runtime instrumentation counters.
+ *
+ * Unlike the tracer, which requires a special build, these counters are
+ * compiled in always and enabled from Python with _jpype.enableStats.
+ * When disabled each probe costs a single test of a global flag.
+ *
+ * Counters are held per thread and only written by the owning thread,
+ * thus no lock or atomic read-modify-write is required on the hot path.
+ * Reading the counters sums over all threads and is approximate while
+ * other threads are running.
+ */
+enum JPStatCounter
+{
+	JPStat_calls = 0,        // Method dispatches
+	JPStat_overloadMisses,   // Dispatches that missed the overload cache
+	JPStat_boundCalls,       // Calls through a bound overload
+	JPStat_conversionTime,   // Nanoseconds converting arguments to Java
+	JPStat_gilReleases,      // Number of JPPyCallRelease scopes
+	JPStat_gilReleaseTime,   // Nanoseconds with the GIL released
+	JPStat_gilWaitTime,      // Nanoseconds waiting to reacquire the GIL
+	JPStat_gilHeld,          // Java calls made without releasing the GIL
+	JPStat_frames,           // Java local frames pushed
+	JPStat_globalRefs,       // Java global references created
+	JPStat_proxyCallbacks,   // Calls from Java into Python proxies
+	JPStat_proxyCacheHits,   // Callables converted using an existing proxy
+	JPStat_proxyCacheMisses, // Callables converted by creating a proxy
+	JPStat_arrayPins,        // Array buffers pinned in place
+	JPStat_arrayPinCopies,   // Pins for which the JVM made a copy
+	JPStat_arrayCopyBytes,   // Bytes copied into Python owned array buffers
+	JPStat_COUNT
+} ;
+
+extern int _jp_stats_enabled;
+
+/** Get the monotonic time in nanoseconds. */
+long long JPStats_clock();
+
+/** Add to a counter for the current thread. */
+void JPStats_add(int counter, long long value);
+
+/** Get the total of all counters over all threads. */
+void JPStats_get(long long *values);
+
+/** Get the name used for a counter when reporting. */
+const char *JPStats_getName(int counter);
+
+/** Clear all counters. */
+void JPStats_reset();
+
+#define JP_STAT_ADD(counter, value) if (_jp_stats_enabled) JPStats_add(counter, value)
+#define JP_STAT_INC(counter) JP_STAT_ADD(counter, 1)
+
+/**
+ * Accumulate the time spent in a scope to a counter.
+ */
+class JPStatTimer
+{
+public:
+
+	JPStatTimer(int counter)
+	: m_Counter(counter), m_Start(_jp_stats_enabled ? JPStats_clock() : 0)
+	{
+	}
+
+	~JPStatTimer()
+	{
+		if (m_Start != 0)
+			JPStats_add(m_Counter, JPStats_clock() - m_Start);
+	}
+
+private:
+	int m_Counter;
+	long long m_Start;
+} ;
+
+#endif /* JP_STATS_H */
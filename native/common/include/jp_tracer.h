@@ -37,7 +37,9 @@
 #define JP_TRACE_JAVA(m, obj) JPypeTracer::traceJavaObject(m, obj)
 #else
 #ifndef JP_INSTRUMENTATION
-#define JP_TRACE_IN(...) try { do {} while (0)
+#define JP_TRACE_IN(...) \
+  JPTraceScope _trace(__VA_ARGS__); \
+  try { do {} while (0)
 #endif
 #define JP_TRACE_OUT } catch (JPypeException &ex) { ex.from(JP_STACKINFO()); throw; }
 #define JP_TRACE(...)
@@ -49,10 +51,68 @@
 // Enable this option to get all the py referencing information
 #define JP_ENABLE_TRACE_PY
 
+/**
+ * Runtime event tracing.
+ *
+ * Scopes opened with JP_TRACE_IN and the transitions between Python and
+ * Java are recorded with a timestamp into a ring buffer owned by each
+ * thread.  Recording is enabled with _jpype.enableTraceEvents and does
+ * not require a special build.  While disabled a scope costs one branch on
+ * entry and one on exit.  The buffers are dumped as Chrome trace event JSON
+ * which can be viewed with chrome://tracing or Perfetto.
+ *
+ * The buffers are only written by the owning thread so no locks are taken
+ * while recording.  When a buffer is full the oldest events are overwritten.
+ */
+extern "C" int _jp_trace_events;
+
+namespace JPTraceEvents
+{
+
+enum Category
+{
+	_scope = 0,
+	_transition = 1
+} ;
+
+void begin(const char *name, char category);
+void end(const char *name, char category);
+
+/** Write all recorded events to a file.
+ *
+ * @return false if the file could not be written.
+ */
+bool dump(const char *filename);
+
+/** Discard all recorded events. */
+void clear();
+}
+
+class JPTraceScope
+{
+public:
+
+	JPTraceScope(const char *name, const void *ref = 0)
+	: m_Name(_jp_trace_events ? name : 0)
+	{
+		if (m_Name != 0)
+			JPTraceEvents::begin(m_Name, JPTraceEvents::_scope);
+	}
+
+	~JPTraceScope()
+	{
+		if (m_Name != 0)
+			JPTraceEvents::end(m_Name, JPTraceEvents::_scope);
+	}
+
+private:
+	const char *m_Name;
+} ;
+
 class JPypeTracer
 {
 private:
-	string m_Name;
+	const char *m_Name;
 	bool m_Error;
 	JPypeTracer *m_Last;
 
@@ -59,7 +59,7 @@ public:
 			jarray a, jsize start, jsize len,
 			void* memory, int offset) override;
 	virtual PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer& view, int subs, int base, jobject dims) override;
+			JPPyBuffer& view, int subs, int base) override;
 } ;
 
 #endif // _JP_VOID_TYPE_H_
\ No newline at end of file
@@ -132,6 +132,25 @@ typedef jvalue (*jconverter)(void*) ;
  */
 extern jconverter getConverter(const char* from, int itemsize, const char* to);
 
+/**
+ * Bulk converters transfer a contiguous run of items in one call.
+ */
+typedef void (*jbulkconverter)(void* dest, void* src, jsize n);
+
+/**
+ * Create a bulk converter for a contiguous source and destination.
+ *
+ * This is an optional fast path for getConverter.  It has the same casting
+ * rules but processes a whole row per call so that widening from unsigned
+ * and half precision sources can be vectorized.
+ *
+ * @param from is a Python struct designation
+ * @param itemsize is the size of the Python item
+ * @param to is the desired Java primitive type
+ * @return a bulk converter or 0 if the pair must be converted element-wise.
+ */
+extern jbulkconverter getBulkConverter(const char* from, int itemsize, const char* to);
+
 extern bool _jp_cpp_exceptions;
 
 // Types
@@ -191,6 +210,7 @@ typedef _object PyObject;
 #include "jp_context.h"
 #include "jp_exception.h"
 #include "jp_tracer.h"
+#include "jp_stats.h"
 #include "jp_pythontypes.h"
 #include "jp_typemanager.h"
 #include "jp_encoding.h"
@@ -0,0 +1,291 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "jp_arena.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Blocks are aligned to a cache line so that neighboring messages do not
+// share a line between threads.
+static const size_t ARENA_ALIGN = 64;
+static const size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+static size_t roundUp(size_t v, size_t align)
+{
+	return (v + align - 1) / align * align;
+}
+
+static char* mapRegion(size_t& size, bool hugePages)
+{
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	if (hugePages && GetLargePageMinimum() > 0)
+	{
+		size_t large = roundUp(size, GetLargePageMinimum());
+		void* ptr = VirtualAlloc(NULL, large, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (ptr != NULL)
+		{
+			size = large;
+			return (char*) ptr;
+		}
+	}
+	size = roundUp(size, info.dwAllocationGranularity);
+	return (char*) VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+	void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+	if (hugePages)
+	{
+		size_t large = roundUp(size, HUGE_PAGE);
+		ptr = mmap(NULL, large, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (ptr != MAP_FAILED)
+		{
+			size = large;
+			return (char*) ptr;
+		}
+	}
+#endif
+	size = roundUp(size, (size_t) sysconf(_SC_PAGESIZE));
+	ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED)
+		return NULL;
+#ifdef MADV_HUGEPAGE
+	// Fall back to transparent huge pages if reserved pages were not available
+	if (hugePages)
+		madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+	return (char*) ptr;
+#endif
+}
+
+static void unmapRegion(char* address, size_t size)
+{
+#ifdef WIN32
+	VirtualFree(address, 0, MEM_RELEASE);
+#else
+	munmap(address, size);
+#endif
+}
+
+JPArena::JPArena(JPJavaFrame& frame, size_t size, bool hugePages)
+{
+	JP_TRACE_IN("JPArena::JPArena");
+	m_Context = frame.getContext();
+	m_Size = size;
+	m_Used = 0;
+	m_Epoch = 0;
+	m_References = 0;
+	m_Closed = false;
+	m_SliceClass = NULL;
+	m_Buffer = NULL;
+	// Java buffers are indexed by int
+	if (size == 0 || size > 0x7fffffffu - HUGE_PAGE)
+		JP_RAISE(PyExc_ValueError, "arena size out of range");
+	m_Address = mapRegion(m_Size, hugePages);
+	if (m_Address == NULL)
+		JP_RAISE(PyExc_MemoryError, "unable to map arena");
+
+	try
+	{
+		jclass cls = (jclass) m_Context->_java_nio_ByteBuffer->getJavaClass();
+
+		// Java 13 added a single call slice, use it if available
+		m_Slice = frame.getEnv()->GetMethodID(cls, "slice", "(II)Ljava/nio/ByteBuffer;");
+		m_Duplicate = NULL;
+		m_Position = NULL;
+		m_Limit = NULL;
+		if (m_Slice == NULL)
+		{
+			// Otherwise slice a duplicate with its position and limit set
+			frame.ExceptionClear();
+			m_Slice = frame.GetMethodID(cls, "slice", "()Ljava/nio/ByteBuffer;");
+			m_Duplicate = frame.GetMethodID(cls, "duplicate", "()Ljava/nio/ByteBuffer;");
+			m_Position = frame.GetMethodID(cls, "position", "(I)Ljava/nio/Buffer;");
+			m_Limit = frame.GetMethodID(cls, "limit", "(I)Ljava/nio/Buffer;");
+		}
+
+		jobject buffer = frame.NewDirectByteBuffer(m_Address, m_Size);
+		m_Buffer = frame.NewGlobalRef(buffer);
+
+		// One share belongs to Python and one to the Java parent buffer
+		m_References = 2;
+		frame.registerRef(buffer, this, &JPArena::releaseHook);
+	} catch (...)
+	{
+		if (m_Buffer != NULL)
+			m_Context->ReleaseGlobalRef(m_Buffer);
+		unmapRegion(m_Address, m_Size);
+		throw;
+	}
+	m_Free[0] = m_Size;
+	JP_TRACE_OUT;
+}
+
+JPArena::~JPArena()
+{
+	unmapRegion(m_Address, m_Size);
+}
+
+void JPArena::releaseHook(void* host)
+{
+	JPArena* arena = (JPArena*) host;
+	if (--arena->m_References == 0)
+		delete arena;
+}
+
+void JPArena::close()
+{
+	{
+		std::lock_guard<std::mutex> guard(m_Lock);
+		if (m_Closed)
+			return;
+		m_Closed = true;
+		m_Context->ReleaseGlobalRef(m_Buffer);
+		m_Buffer = NULL;
+		m_Free.clear();
+		m_Blocks.clear();
+		m_Used = 0;
+	}
+	// This may delete the arena so it must be outside the lock
+	releaseHook(this);
+}
+
+jobject JPArena::allocate(JPJavaFrame& frame, size_t size)
+{
+	JP_TRACE_IN("JPArena::allocate");
+	std::lock_guard<std::mutex> guard(m_Lock);
+	if (m_Closed)
+		JP_RAISE(PyExc_ValueError, "arena is closed");
+	size_t request = roundUp(size == 0 ? 1 : size, ARENA_ALIGN);
+
+	// First fit from the lowest address keeps the live blocks compact
+	std::map<size_t, size_t>::iterator iter = m_Free.begin();
+	for (; iter != m_Free.end(); ++iter)
+	{
+		if (iter->second >= request)
+			break;
+	}
+	if (iter == m_Free.end())
+		JP_RAISE(PyExc_MemoryError, "arena is exhausted");
+
+	size_t offset = iter->first;
+	size_t remaining = iter->second - request;
+	m_Free.erase(iter);
+	if (remaining > 0)
+		m_Free[offset + request] = remaining;
+	Block &block = m_Blocks[offset];
+	block.m_Size = request;
+	block.m_Epoch = m_Epoch;
+	m_Used += request;
+
+	try
+	{
+		// The slice is sized to the request rather than the rounded block
+		jvalue args[2];
+		if (m_Duplicate == NULL)
+		{
+			args[0].i = (jint) offset;
+			args[1].i = (jint) size;
+			return frame.CallObjectMethodA(m_Buffer, m_Slice, args);
+		}
+		jobject dup = frame.CallObjectMethodA(m_Buffer, m_Duplicate, NULL);
+		args[0].i = (jint) (offset + size);
+		frame.DeleteLocalRef(frame.CallObjectMethodA(dup, m_Limit, args));
+		args[0].i = (jint) offset;
+		frame.DeleteLocalRef(frame.CallObjectMethodA(dup, m_Position, args));
+		jobject out = frame.CallObjectMethodA(dup, m_Slice, NULL);
+		frame.DeleteLocalRef(dup);
+		return out;
+	} catch (...)
+	{
+		freeBlock(offset, request);
+		throw;
+	}
+	JP_TRACE_OUT;
+}
+
+// Called with the lock held
+void JPArena::freeBlock(size_t offset, size_t size)
+{
+	m_Blocks.erase(offset);
+	m_Used -= size;
+
+	// Merge with the neighbors so large blocks can be reused
+	std::map<size_t, size_t>::iterator next = m_Free.lower_bound(offset);
+	if (next != m_Free.end() && next->first == offset + size)
+	{
+		size += next->second;
+		next = m_Free.erase(next);
+	}
+	if (next != m_Free.begin())
+	{
+		std::map<size_t, size_t>::iterator prev = next;
+		--prev;
+		if (prev->first + prev->second == offset)
+		{
+			prev->second += size;
+			return;
+		}
+	}
+	m_Free[offset] = size;
+}
+
+void JPArena::release(JPJavaFrame& frame, jobject buffer)
+{
+	JP_TRACE_IN("JPArena::release");
+	std::lock_guard<std::mutex> guard(m_Lock);
+	if (m_Closed)
+		JP_RAISE(PyExc_ValueError, "arena is closed");
+	char* address = (char*) frame.GetDirectBufferAddress(buffer);
+	if (address < m_Address || address >= m_Address + m_Size)
+		JP_RAISE(PyExc_ValueError, "buffer was not allocated from this arena");
+	std::map<size_t, Block>::iterator iter = m_Blocks.find(address - m_Address);
+	if (iter == m_Blocks.end())
+		JP_RAISE(PyExc_ValueError, "buffer is not an allocated block");
+	freeBlock(iter->first, iter->second.m_Size);
+	JP_TRACE_OUT;
+}
+
+size_t JPArena::advance()
+{
+	std::lock_guard<std::mutex> guard(m_Lock);
+	return ++m_Epoch;
+}
+
+size_t JPArena::reclaim(size_t epoch)
+{
+	JP_TRACE_IN("JPArena::reclaim");
+	std::lock_guard<std::mutex> guard(m_Lock);
+	size_t count = 0;
+	std::map<size_t, Block>::iterator iter = m_Blocks.begin();
+	while (iter != m_Blocks.end())
+	{
+		std::map<size_t, Block>::iterator current = iter++;
+		if (current->second.m_Epoch <= epoch)
+		{
+			freeBlock(current->first, current->second.m_Size);
+			count++;
+		}
+	}
+	return count;
+	JP_TRACE_OUT;
+}
@@ -141,6 +141,7 @@ jarray JPArray::clone(JPJavaFrame& frame, PyObject* obj)
 }
 
 JPArrayView::JPArrayView(JPArray* array)
+: m_Shape(1), m_Strides(1)
 {
 	JPJavaFrame frame = JPJavaFrame::outer(array->m_Class->getContext());
 	m_Array = array;
@@ -154,8 +155,8 @@ JPArrayView::JPArrayView(JPArray* array)
 	m_Shape[0] = array->m_Length;
 	m_Buffer.buf = (char*) m_Memory + m_Buffer.itemsize * array->m_Start;
 	m_Buffer.len = array->m_Length * m_Buffer.itemsize;
-	m_Buffer.shape = m_Shape;
-	m_Buffer.strides = m_Strides;
+	m_Buffer.shape = &m_Shape[0];
+	m_Buffer.strides = &m_Strides[0];
 	m_Buffer.readonly = 1;
 	m_Owned = false;
 }
@@ -185,6 +186,8 @@ JPArrayView::JPArrayView(JPArray* array, jobject collection)
 				&JPJavaFrame::GetIntArrayElements, &JPJavaFrame::ReleaseIntArrayElements);
 		jint* shape2 = accessor.get();
 		dims = frame.GetArrayLength((jarray) item1);
+		m_Shape.resize(dims);
+		m_Strides.resize(dims);
 		itemsize = componentType->getItemSize();
 		sz = itemsize;
 		for (int i = 0; i < dims; ++i)
@@ -209,12 +212,50 @@ JPArrayView::JPArrayView(JPArray* array, jobject collection)
 	// All remaining elements are primitive arrays to be unpacked
 	int offset = 0;
 	Py_ssize_t last = m_Shape[dims - 1];
-	for (Py_ssize_t i = 0; i < len - 2; i++)
+	Py_ssize_t rows = len - 2;
+	int workers = JPParallel::plan(sz);
+	if (workers > 1 && rows >= workers)
 	{
-		jarray a1 = (jarray) frame.GetObjectArrayElement((jobjectArray) collection, (jsize) i + 2);
-		componentType->copyElements(frame, a1, 0, (jsize) last, m_Memory, offset);
-		offset += (int) (itemsize * last);
-		frame.DeleteLocalRef(a1);
+		// Copy batches of rows in parallel while they are pinned
+		Py_ssize_t rowBytes = itemsize * last;
+		Py_ssize_t batch = JPParallel::batch(rowBytes, workers);
+		frame.getEnv()->EnsureLocalCapacity((jint) batch);
+		std::vector<jarray> items;
+		std::vector<void*> mem;
+		char *memory = (char*) m_Memory;
+		for (Py_ssize_t r0 = 0; r0 < rows; r0 += batch)
+		{
+			Py_ssize_t r1 = (r0 + batch < rows) ? r0 + batch : rows;
+			items.clear();
+			mem.clear();
+			for (Py_ssize_t r = r0; r < r1; ++r)
+				items.push_back((jarray) frame.GetObjectArrayElement((jobjectArray) collection, (jsize) r + 2));
+			{
+				// The GIL must not be reacquired until every row is released
+				JPPyCallRelease release;
+				jboolean isCopy;
+				for (size_t r = 0; r < items.size(); ++r)
+					mem.push_back(frame.getEnv()->GetPrimitiveArrayCritical(items[r], &isCopy));
+				JPParallel::forEach(r1 - r0, workers, [&](Py_ssize_t first, Py_ssize_t end)
+				{
+					for (Py_ssize_t r = first; r < end; ++r)
+						memcpy(memory + (r0 + r) * rowBytes, mem[r], rowBytes);
+				});
+				for (size_t r = items.size(); r > 0; --r)
+					frame.getEnv()->ReleasePrimitiveArrayCritical(items[r - 1], mem[r - 1], JNI_ABORT);
+			}
+			for (size_t r = 0; r < items.size(); ++r)
+				frame.DeleteLocalRef(items[r]);
+		}
+	} else
+	{
+		for (Py_ssize_t i = 0; i < rows; i++)
+		{
+			jarray a1 = (jarray) frame.GetObjectArrayElement((jobjectArray) collection, (jsize) i + 2);
+			componentType->copyElements(frame, a1, 0, (jsize) last, m_Memory, offset);
+			offset += (int) (itemsize * last);
+			frame.DeleteLocalRef(a1);
+		}
 	}
 
 	// Copy values into Python buffer for consumption
@@ -225,8 +266,8 @@ JPArrayView::JPArrayView(JPArray* array, jobject collection)
 	m_Buffer.format = const_cast<char*> (componentType->getBufferFormat());
 	m_Buffer.buf = (char*) m_Memory + m_Buffer.itemsize * array->m_Start;
 	m_Buffer.len = sz;
-	m_Buffer.shape = m_Shape;
-	m_Buffer.strides = m_Strides;
+	m_Buffer.shape = &m_Shape[0];
+	m_Buffer.strides = &m_Strides[0];
 	m_Buffer.readonly = 1;
 	JP_TRACE_OUT;  // GCOVR_EXCL_LINE
 }
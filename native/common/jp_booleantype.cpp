@@ -235,36 +235,13 @@ void JPBooleanType::setArrayRange(JPJavaFrame& frame, jarray a,
 		PyObject* sequence)
 {
 	JP_TRACE_IN("JPBooleanType::setArrayRange");
-	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
-			&JPJavaFrame::GetBooleanArrayElements, &JPJavaFrame::ReleaseBooleanArrayElements);
-
-	type_t* val = accessor.get();
 	// First check if assigning sequence supports buffer API
 	if (PyObject_CheckBuffer(sequence))
 	{
 		JPPyBuffer buffer(sequence, PyBUF_FULL_RO);
 		if (buffer.valid())
 		{
-			Py_buffer& view = buffer.getView();
-			if (view.ndim != 1)
-				JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
-			Py_ssize_t vshape = view.shape[0];
-			Py_ssize_t vstep = view.strides[0];
-			if (vshape != length)
-				JP_RAISE(PyExc_ValueError, "mismatched size");
-
-			char* memory = (char*) view.buf;
-			if (view.suboffsets && view.suboffsets[0] >= 0)
-				memory = *((char**) memory) + view.suboffsets[0];
-			jsize index = start;
-			jconverter conv = getConverter(view.format, (int) view.itemsize, "z");
-			for (Py_ssize_t i = 0; i < length; ++i, index += step)
-			{
-				jvalue r = conv(memory);
-				val[index] = r.z;
-				memory += vstep;
-			}
-			accessor.commit();
+			setArrayFromBuffer<JPBooleanType>(frame, a, start, length, step, buffer, "z");
 			return;
 		} else
 		{
@@ -272,6 +249,10 @@ void JPBooleanType::setArrayRange(JPJavaFrame& frame, jarray a,
 		}
 	}
 
+	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
+			&JPJavaFrame::GetBooleanArrayElements, &JPJavaFrame::ReleaseBooleanArrayElements);
+
+	type_t* val = accessor.get();
 	// Use sequence API
 	JPPySequence seq = JPPySequence::use(sequence);
 	jsize index = start;
@@ -350,11 +331,11 @@ static void pack(jboolean* d, jvalue v)
 	*d = v.z;
 }
 
-PyObject *JPBooleanType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
+PyObject *JPBooleanType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base)
 {
 	JP_TRACE_IN("JPBooleanType::newMultiArray");
 	return convertMultiArray<type_t>(
 			frame, this, &pack, "z",
-			buffer, subs, base, dims);
+			buffer, subs, base);
 	JP_TRACE_OUT;
 }
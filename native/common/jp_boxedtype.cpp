@@ -13,6 +13,7 @@
 
    See NOTICE file for details.
  *****************************************************************************/
+#include <algorithm>
 #include "jpype.h"
 #include "pyjp.h"
 #include "jp_boxedtype.h"
@@ -26,12 +27,44 @@ JPBoxedType::JPBoxedType(JPJavaFrame& frame, jclass clss,
 : JPClass(frame, clss, name, super, interfaces, modifiers),
 m_PrimitiveType(primitiveType)
 {
+	m_CtorID = NULL;
+	m_ValueOfID = NULL;
+	m_CacheLow = 0;
+	m_CacheHigh = -1;
 	if (name != "java.lang.Void")
 	{
 		string s = string("(") + primitiveType->getTypeCode() + ")V";
 		m_CtorID = frame.GetMethodID(clss, "<init>", s.c_str());
+		string jname = name;
+		std::replace(jname.begin(), jname.end(), '.', '/');
+		s = string("(") + primitiveType->getTypeCode() + ")L" + jname + ";";
+		m_ValueOfID = frame.GetStaticMethodID(clss, "valueOf", s.c_str());
 	}
 
+	// Match the range that valueOf is required to cache.
+	switch (primitiveType->getTypeCode())
+	{
+		case 'Z':
+			m_CacheLow = 0;
+			m_CacheHigh = 1;
+			break;
+		case 'C':
+			m_CacheLow = 0;
+			m_CacheHigh = 127;
+			break;
+		case 'B':
+		case 'S':
+		case 'I':
+		case 'J':
+			m_CacheLow = -128;
+			m_CacheHigh = 127;
+			break;
+	}
+	if (m_CacheHigh >= m_CacheLow)
+		m_Cache = std::vector<std::atomic<jobject> >((size_t) (m_CacheHigh - m_CacheLow + 1));
+	for (size_t i = 0; i < m_Cache.size(); ++i)
+		m_Cache[i].store(NULL);
+
 	m_DoubleValueID = NULL;
 	m_FloatValueID = NULL;
 	m_LongValueID = NULL;
@@ -61,6 +94,12 @@ m_PrimitiveType(primitiveType)
 
 JPBoxedType::~JPBoxedType()
 {
+	for (size_t i = 0; i < m_Cache.size(); ++i)
+	{
+		jobject obj = m_Cache[i].load();
+		if (obj != NULL)
+			m_Context->ReleaseGlobalRef(obj);
+	}
 }
 
 JPMatch::Type JPBoxedType::findJavaConversion(JPMatch &match)
@@ -97,7 +136,40 @@ void JPBoxedType::getConversionInfo(JPConversionInfo &info)
 
 jobject JPBoxedType::box(JPJavaFrame &frame, jvalue v)
 {
-	return frame.NewObjectA(m_Class.get(), m_CtorID, &v);
+	jlong key;
+	switch (m_PrimitiveType->getTypeCode())
+	{
+		case 'Z': key = v.z;
+			break;
+		case 'C': key = v.c;
+			break;
+		case 'B': key = v.b;
+			break;
+		case 'S': key = v.s;
+			break;
+		case 'I': key = v.i;
+			break;
+		case 'J': key = v.j;
+			break;
+		default:
+			return frame.CallStaticObjectMethodA(m_Class.get(), m_ValueOfID, &v);
+	}
+	if (key < m_CacheLow || key > m_CacheHigh)
+		return frame.CallStaticObjectMethodA(m_Class.get(), m_ValueOfID, &v);
+
+	// Entries are filled on first use.  Threads that race to fill an entry
+	// keep the first reference and release their own.
+	std::atomic<jobject> &entry = m_Cache[(size_t) (key - m_CacheLow)];
+	jobject cached = entry.load(std::memory_order_acquire);
+	if (cached == NULL)
+	{
+		jobject obj = frame.CallStaticObjectMethodA(m_Class.get(), m_ValueOfID, &v);
+		jobject ref = frame.NewGlobalRef(obj);
+		if (!entry.compare_exchange_strong(cached, ref, std::memory_order_acq_rel))
+			frame.DeleteGlobalRef(ref);
+		return obj;
+	}
+	return frame.NewLocalRef(cached);
 }
 
 JPPyObject JPBoxedType::convertToPythonObject(JPJavaFrame& frame, jvalue value, bool cast)
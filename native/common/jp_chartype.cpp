@@ -291,11 +291,11 @@ static void pack(jchar* d, jvalue v)
 	*d = v.c;
 }
 
-PyObject *JPCharType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
+PyObject *JPCharType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base)
 {
 	JP_TRACE_IN("JPCharType::newMultiArray");
 	return convertMultiArray<type_t>(
 			frame, this, &pack, "c",
-			buffer, subs, base, dims);
+			buffer, subs, base);
 	JP_TRACE_OUT;
 }
@@ -13,6 +13,7 @@
 
    See NOTICE file for details.
  *****************************************************************************/
+#include <algorithm>
 #include "jpype.h"
 #include "pyjp.h"
 #include "jp_field.h"
@@ -28,6 +29,7 @@ JPClass::JPClass(
 	m_SuperClass = NULL;
 	m_Interfaces = JPClassList();
 	m_Modifiers = modifiers;
+	m_HostPtr = NULL;
 }
 
 JPClass::JPClass(JPJavaFrame& frame,
@@ -43,15 +45,34 @@ JPClass::JPClass(JPJavaFrame& frame,
 	m_SuperClass = super;
 	m_Interfaces = interfaces;
 	m_Modifiers = modifiers;
+	m_HostPtr = NULL;
+
+	// The parents are always created first, so their supertypes are complete.
+	if (super != NULL)
+	{
+		m_SuperTypes.push_back(super);
+		m_SuperTypes.insert(m_SuperTypes.end(), super->m_SuperTypes.begin(), super->m_SuperTypes.end());
+	}
+	for (JPClassList::const_iterator iter = interfaces.begin(); iter != interfaces.end(); ++iter)
+	{
+		m_SuperTypes.push_back(*iter);
+		m_SuperTypes.insert(m_SuperTypes.end(), (*iter)->m_SuperTypes.begin(), (*iter)->m_SuperTypes.end());
+	}
+	std::sort(m_SuperTypes.begin(), m_SuperTypes.end());
+	m_SuperTypes.erase(std::unique(m_SuperTypes.begin(), m_SuperTypes.end()), m_SuperTypes.end());
 }
 
 JPClass::~JPClass()
 {
 }
 
-void JPClass::setHost(PyObject* host)
+bool JPClass::setHost(PyObject* host)
 {
+	PyObject* expected = NULL;
+	if (!m_HostPtr.compare_exchange_strong(expected, host, std::memory_order_acq_rel))
+		return false;
 	m_Host = JPPyObject::use(host);
+	return true;
 }
 
 void JPClass::setHints(PyObject* host)
@@ -433,4 +454,12 @@ bool JPClass::isAssignableFrom(JPJavaFrame& frame, JPClass* o)
 	return frame.IsAssignableFrom(m_Class.get(), o->getJavaClass()) != 0;
 }
 
+bool JPClass::isSubTypeOf(JPClass* o) const
+{
+	// Interfaces do not list Object as a parent but are assignable to it.
+	if (o == this || o == m_Context->_java_lang_Object)
+		return true;
+	return std::binary_search(m_SuperTypes.begin(), m_SuperTypes.end(), o);
+}
+
 //</editor-fold>
@@ -17,6 +17,7 @@
 #include "jpype.h"
 #include "jp_classhints.h"
 #include "jp_arrayclass.h"
+#include "jp_boxedtype.h"
 #include "jp_stringtype.h"
 #include "jp_proxy.h"
 #include "pyjp.h"
@@ -85,13 +86,55 @@ JPConversion::~JPConversion()
 {
 }
 
+/**
+ * Base for conversions added by the user.
+ */
+class JPHintConversion : public JPConversion
+{
+public:
+
+	/**
+	 * Check if the outcome of matches depends only on the type.
+	 *
+	 * @param type is the type of the object that was matched.
+	 * @returns true if the result can be reused for all instances of the type.
+	 */
+	virtual bool isTypeDetermined(PyTypeObject *type)
+	{
+		return true;
+	}
+} ;
+
+// Limit on the number of types memoized for each class.
+static const size_t JP_HINTS_CACHE_SIZE = 256;
+
+/**
+ * Get the version tag of a type.
+ *
+ * Python changes the tag whenever the type or one of its bases is modified.
+ *
+ * @returns the tag or 0 if the type does not currently have a valid one.
+ */
+static unsigned int getVersionTag(PyTypeObject *type)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+	if (type->tp_version_tag == 0)
+		PyUnstable_Type_AssignVersionTag(type);
+#endif
+#ifdef Py_TPFLAGS_VALID_VERSION_TAG
+	if (!PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+		return 0;
+#endif
+	return type->tp_version_tag;
+}
+
 JPClassHints::JPClassHints()
 {
 }
 
 JPClassHints::~JPClassHints()
 {
-	for (std::list<JPConversion*>::iterator iter = conversions.begin();
+	for (std::list<JPHintConversion*>::iterator iter = conversions.begin();
 			iter != conversions.end(); ++iter)
 	{
 		delete *iter;
@@ -99,22 +142,73 @@ JPClassHints::~JPClassHints()
 	conversions.clear();
 }
 
+void JPClassHints::clearCache()
+{
+	// The entries are released outside the lock as that touches Python
+	std::map<PyTypeObject*, CacheEntry> old;
+	{
+		std::lock_guard<std::mutex> guard(m_CacheLock);
+		old.swap(m_Cache);
+	}
+}
+
 JPMatch::Type JPClassHints::getConversion(JPMatch& match, JPClass *cls)
 {
-	JPConversion *best = NULL;
-	for (std::list<JPConversion*>::iterator iter = conversions.begin();
+	if (conversions.empty())
+		return match.type = JPMatch::_none;
+
+	PyTypeObject *type = Py_TYPE(match.object);
+	{
+		std::lock_guard<std::mutex> guard(m_CacheLock);
+		std::map<PyTypeObject*, CacheEntry>::iterator cached = m_Cache.find(type);
+		if (cached != m_Cache.end() && cached->second.version != 0
+				&& cached->second.version == getVersionTag(type))
+		{
+			CacheEntry &entry = cached->second;
+			match.conversion = entry.conversion;
+			if (entry.conversion != NULL)
+				match.closure = cls;
+			return match.type = entry.quality;
+		}
+	}
+
+	bool determined = true;
+	JPHintConversion *best = NULL;
+	for (std::list<JPHintConversion*>::iterator iter = conversions.begin();
 			iter != conversions.end(); ++iter)
 	{
 		JPMatch::Type quality = (*iter)->matches(cls, match);
+		determined &= (*iter)->isTypeDetermined(type);
 		if (quality > JPMatch::_explicit)
-			return match.type;
+		{
+			best = (*iter);
+			break;
+		}
 		if (quality != JPMatch::_none)
 			best = (*iter);
 	}
-	match.conversion = best;
-	if (best == NULL)
-		return match.type = JPMatch::_none;
-	return match.type = JPMatch::_explicit;
+
+	if (best == NULL || match.conversion != best)
+	{
+		match.conversion = best;
+		match.type = (best == NULL) ? JPMatch::_none : JPMatch::_explicit;
+	}
+
+	unsigned int version = determined ? getVersionTag(type) : 0;
+	if (version != 0)
+	{
+		JPPyObject hold = JPPyObject::use((PyObject*) type);
+		std::map<PyTypeObject*, CacheEntry> old;
+		std::lock_guard<std::mutex> guard(m_CacheLock);
+		if (m_Cache.size() >= JP_HINTS_CACHE_SIZE)
+			old.swap(m_Cache);
+		CacheEntry &entry = m_Cache[type];
+		entry.type = hold;
+		entry.version = version;
+		entry.conversion = match.conversion;
+		entry.quality = match.type;
+	}
+	return match.type;
 }
 
 void JPIndexConversion::getInfo(JPClass *cls, JPConversionInfo &info)
@@ -135,7 +229,7 @@ void JPNumberConversion::getInfo(JPClass *cls, JPConversionInfo &info)
 /**
  * Conversion for all user specified conversions.
  */
-class JPPythonConversion : public JPConversion
+class JPPythonConversion : public JPHintConversion
 {
 public:
 
@@ -188,6 +282,7 @@ public:
 	JPAttributeConversion(const string &attribute, PyObject *method)
 	: JPPythonConversion(method), attribute_(attribute)
 	{
+		name_ = JPPyString::fromStringUTF8(attribute);
 	}
 
 	virtual ~JPAttributeConversion()  // GCOVR_EXCL_LINE
@@ -197,7 +292,7 @@ public:
 	virtual JPMatch::Type matches(JPClass *cls, JPMatch &match) override
 	{
 		JP_TRACE_IN("JPAttributeConversion::matches");
-		JPPyObject attr = JPPyObject::accept(PyObject_GetAttrString(match.object, attribute_.c_str()));
+		JPPyObject attr = JPPyObject::accept(PyObject_GetAttr(match.object, name_.get()));
 		if (attr.isNull())
 			return JPMatch::_none;
 		match.conversion = this;
@@ -206,6 +301,22 @@ public:
 		JP_TRACE_OUT;
 	}
 
+	/**
+	 * Attributes of the class are seen by every instance.  Missing ones can
+	 * only be ruled out from the type when instances can not hold attributes
+	 * of their own.  Names that come from the metaclass are not inherited by
+	 * instances and so tell us nothing.
+	 */
+	virtual bool isTypeDetermined(PyTypeObject *type) override
+	{
+		if (type->tp_getattro != PyObject_GenericGetAttr)
+			return false;
+		if (type->tp_dictoffset == 0)
+			return true;
+		return PyObject_HasAttr((PyObject*) type, name_.get())
+				&& !PyObject_HasAttr((PyObject*) Py_TYPE(type), name_.get());
+	}
+
 	virtual void getInfo(JPClass *cls, JPConversionInfo &info) override
 	{
 		PyList_Append(info.attributes, JPPyString::fromStringUTF8(attribute_).get());
@@ -214,6 +325,7 @@ public:
 
 private:
 	std::string attribute_;
+	JPPyObject name_;
 
 } ;
 
@@ -221,6 +333,7 @@ void JPClassHints::addAttributeConversion(const string &attribute, PyObject *con
 {
 	JP_TRACE_IN("JPClassHints::addAttributeConversion", this);
 	JP_TRACE(attribute);
+	clearCache();
 	conversions.push_back(new JPAttributeConversion(attribute, conversion));
 	JP_TRACE_OUT;
 }
@@ -228,7 +341,7 @@ void JPClassHints::addAttributeConversion(const string &attribute, PyObject *con
 //</editor-fold>
 //<editor-fold desc="type conversion" defaultstate="collapsed">
 
-class JPNoneConversion : public JPConversion
+class JPNoneConversion : public JPHintConversion
 {
 public:
 
@@ -253,6 +366,11 @@ public:
 		JP_TRACE_OUT;
 	}
 
+	virtual bool isTypeDetermined(PyTypeObject *type) override
+	{
+		return Py_TYPE(type_.get()) == &PyType_Type;
+	}
+
 	virtual void getInfo(JPClass *cls, JPConversionInfo &info) override
 	{
 		PyList_Append(info.none, type_.get());
@@ -295,6 +413,18 @@ public:
 		JP_TRACE_OUT;
 	}
 
+	/**
+	 * Instance checks against a plain class follow the MRO of the object
+	 * type.  Abstract base classes and protocols may decide per instance or
+	 * change their answer when a class is registered later.
+	 */
+	virtual bool isTypeDetermined(PyTypeObject *type) override
+	{
+		if (exact_ && ((PyObject*) type) == type_.get())
+			return true;
+		return Py_TYPE(type_.get()) == &PyType_Type;
+	}
+
 	virtual void getInfo(JPClass *cls, JPConversionInfo &info) override
 	{
 		PyList_Append(info.implicit, type_.get());
@@ -308,6 +438,7 @@ private:
 void JPClassHints::addTypeConversion(PyObject *type, PyObject *method, bool exact)
 {
 	JP_TRACE_IN("JPClassHints::addTypeConversion", this);
+	clearCache();
 	conversions.push_back(new JPTypeConversion(type, method, exact));
 	JP_TRACE_OUT;
 }
@@ -315,13 +446,14 @@ void JPClassHints::addTypeConversion(PyObject *type, PyObject *method, bool exac
 void JPClassHints::excludeConversion(PyObject *type)
 {
 	JP_TRACE_IN("JPClassHints::addTypeConversion", this);
+	clearCache();
 	conversions.push_front(new JPNoneConversion(type));
 	JP_TRACE_OUT;
 }
 
 void JPClassHints::getInfo(JPClass *cls, JPConversionInfo &info)
 {
-	for (std::list<JPConversion*>::iterator iter = conversions.begin();
+	for (std::list<JPHintConversion*>::iterator iter = conversions.begin();
 			iter != conversions.end(); ++iter)
 	{
 		(*iter)->getInfo(cls, info);
@@ -726,14 +858,78 @@ public:
 	virtual jvalue convert(JPMatch &match) override
 	{
 		jvalue res;
+		JPBoxedType *cls = (JPBoxedType*) match.closure;
+
+		// Convert to the primitive and box with valueOf semantics so that
+		// the cached instances are shared.
+		JPMatch pmatch(match.frame, match.object);
+		if (cls->getPrimitive()->findJavaConversion(pmatch) >= JPMatch::_implicit)
+		{
+			res.l = cls->box(*match.frame, pmatch.convert());
+			return res;
+		}
+
+		// Let the constructors report the problem
 		JPPyObjectVector args(match.object, NULL);
-		JPClass *cls = (JPClass*) match.closure;
 		JPValue pobj = cls->newInstance(*match.frame, args);
 		res.l = pobj.getJavaObject();
 		return res;
 	}
 } ;
 
+/**
+ * Sized numpy scalar types box to the matching Java type.
+ *
+ * The name of each type is only examined the first time it is seen.
+ */
+enum JPNumpyBox
+{
+	_numpyNone = 0,
+	_numpyByte,
+	_numpyShort,
+	_numpyInt,
+	_numpyFloat
+} ;
+
+static JPNumpyBox findNumpyBox(PyTypeObject *type)
+{
+	static std::map<PyTypeObject*, JPNumpyBox> cache;
+	static std::mutex lock;
+	if (type == &PyLong_Type || type == &PyFloat_Type)
+		return _numpyNone;
+
+	// Heap types may be freed and their address reused so only static types
+	// are held.
+	bool hold = !PyType_HasFeature(type, Py_TPFLAGS_HEAPTYPE);
+	if (hold)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		std::map<PyTypeObject*, JPNumpyBox>::iterator iter = cache.find(type);
+		if (iter != cache.end())
+			return iter->second;
+	}
+
+	JPNumpyBox code = _numpyNone;
+	const char *name = type->tp_name;
+	if (strncmp(name, "numpy", 5) == 0)
+	{
+		if (strcmp(&name[5], ".int8") == 0)
+			code = _numpyByte;
+		else if (strcmp(&name[5], ".int16") == 0)
+			code = _numpyShort;
+		else if (strcmp(&name[5], ".int32") == 0)
+			code = _numpyInt;
+		else if (strcmp(&name[5], ".float32") == 0)
+			code = _numpyFloat;
+	}
+	if (hold)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		cache[type] = code;
+	}
+	return code;
+}
+
 class JPConversionBoxBoolean : public JPConversionBox
 {
 public:
@@ -783,19 +979,21 @@ public:
 
 	jvalue convert(JPMatch &match) override
 	{
-		PyTypeObject* type = Py_TYPE(match.object);
-		JPJavaFrame *frame = match.frame;
-		const char *name = type->tp_name;
-		match.closure = frame->getContext()->_java_lang_Long;
-		if (strncmp(name, "numpy", 5) == 0)
+		JPContext *context = match.frame->getContext();
+		// We only handle specific sized types, all others go to long.
+		switch (findNumpyBox(Py_TYPE(match.object)))
 		{
-			// We only handle specific sized types, all others go to long.
-			if (strcmp(&name[5], ".int8") == 0)
-				match.closure = frame->getContext()->_java_lang_Byte;
-			else if (strcmp(&name[5], ".int16") == 0)
-				match.closure = frame->getContext()->_java_lang_Short;
-			else if (strcmp(&name[5], ".int32") == 0)
-				match.closure = frame->getContext()->_java_lang_Integer;
+			case _numpyByte:
+				match.closure = context->_java_lang_Byte;
+				break;
+			case _numpyShort:
+				match.closure = context->_java_lang_Short;
+				break;
+			case _numpyInt:
+				match.closure = context->_java_lang_Integer;
+				break;
+			default:
+				match.closure = context->_java_lang_Long;
 		}
 		return JPConversionBox::convert(match);
 	}
@@ -828,16 +1026,12 @@ public:
 
 	virtual jvalue convert(JPMatch &match) override
 	{
-		JPJavaFrame *frame = match.frame;
-		PyTypeObject* type = Py_TYPE(match.object);
-		const char *name = type->tp_name;
-		match.closure = frame->getContext()->_java_lang_Double;
-		if (strncmp(name, "numpy", 5) == 0)
-		{
-			// We only handle specific sized types, all others go to double.
-			if (strcmp(&name[5], ".float32") == 0)
-				match.closure = frame->getContext()->_java_lang_Float;
-		}
+		JPContext *context = match.frame->getContext();
+		// We only handle specific sized types, all others go to double.
+		if (findNumpyBox(Py_TYPE(match.object)) == _numpyFloat)
+			match.closure = context->_java_lang_Float;
+		else
+			match.closure = context->_java_lang_Double;
 		return JPConversionBox::convert(match);
 	}
 } _boxDoubleConversion;
@@ -877,8 +1071,8 @@ public:
 		{
 			// Okay we need to box it.
 			JPPrimitiveType* type = (JPPrimitiveType*) (value->getClass());
-			match.closure = type->getBoxedClass(frame->getContext());
-			res = JPConversionBox::convert(match);
+			JPBoxedType *boxed = (JPBoxedType*) type->getBoxedClass(frame->getContext());
+			res.l = boxed->box(*frame, value->getValue());
 			return res;
 		}
 	}
@@ -968,10 +1162,10 @@ public:
 			return match.type = JPMatch::_none;
 
 		// Check if any of the interfaces matches ...
-		vector<JPClass*> itf = proxy->getInterfaces();
+		const JPClassList& itf = proxy->getInterfaces();
 		for (unsigned int i = 0; i < itf.size(); i++)
 		{
-			if (match.frame->IsAssignableFrom(itf[i]->getJavaClass(), cls->getJavaClass()))
+			if (itf[i]->isSubTypeOf(cls))
 			{
 				JP_TRACE("implicit proxy");
 				match.conversion = this;
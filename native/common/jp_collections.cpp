@@ -0,0 +1,286 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include <vector>
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_collections.h"
+
+namespace
+{
+
+// Must match org.jpype.JPypeCollections
+enum
+{
+	CODE_NULL = 0,
+	CODE_STRING = 1,
+	CODE_BOOLEAN = 2,
+	CODE_LONG = 3,
+	CODE_DOUBLE = 4,
+	CODE_MAP = 5,
+	CODE_LIST = 6,
+	CODE_OBJECT = 7
+} ;
+
+const int MAX_DEPTH = 1000;
+
+class JPCollectionEncoder
+{
+public:
+
+	void visit(PyObject* obj, int depth)
+	{
+		if (depth > MAX_DEPTH)
+			JP_RAISE(PyExc_ValueError, "collection is nested too deeply");
+		if (obj == Py_None)
+		{
+			m_Codes.push_back(CODE_NULL);
+		} else if (PyUnicode_CheckExact(obj))
+		{
+			m_Codes.push_back(CODE_STRING);
+			m_Objects.push_back(JPPyObject::use(obj));
+		} else if (PyBool_Check(obj))
+		{
+			m_Codes.push_back(CODE_BOOLEAN);
+			m_Longs.push_back(obj == Py_True);
+		} else if (PyLong_CheckExact(obj))
+		{
+			int overflow = 0;
+			jlong v = PyLong_AsLongLongAndOverflow(obj, &overflow);
+			if (overflow != 0)
+			{
+				// Leave it for the implicit conversion to report
+				m_Codes.push_back(CODE_OBJECT);
+				m_Objects.push_back(JPPyObject::use(obj));
+				return;
+			}
+			m_Codes.push_back(CODE_LONG);
+			m_Longs.push_back(v);
+		} else if (PyFloat_CheckExact(obj))
+		{
+			m_Codes.push_back(CODE_DOUBLE);
+			m_Doubles.push_back(PyFloat_AsDouble(obj));
+		} else if (PyDict_Check(obj))
+		{
+			m_Codes.push_back(CODE_MAP);
+			m_Longs.push_back(PyDict_Size(obj));
+			Py_ssize_t pos = 0;
+			PyObject *key, *value;
+			while (PyDict_Next(obj, &pos, &key, &value))
+			{
+				visit(key, depth + 1);
+				visit(value, depth + 1);
+			}
+		} else if (PyList_Check(obj) || PyTuple_Check(obj))
+		{
+			JPPySequence seq = JPPySequence::use(obj);
+			jlong n = seq.size();
+			m_Codes.push_back(CODE_LIST);
+			m_Longs.push_back(n);
+			for (jlong i = 0; i < n; ++i)
+				visit(seq[i].get(), depth + 1);
+		} else
+		{
+			m_Codes.push_back(CODE_OBJECT);
+			m_Objects.push_back(JPPyObject::use(obj));
+		}
+	}
+
+	jobject build(JPJavaFrame& frame)
+	{
+		JPContext *context = frame.getContext();
+		jbyteArray codes = frame.NewByteArray((jsize) m_Codes.size());
+		frame.SetByteArrayRegion(codes, 0, (jsize) m_Codes.size(), m_Codes.data());
+		jlongArray longs = frame.NewLongArray((jsize) m_Longs.size());
+		frame.SetLongArrayRegion(longs, 0, (jsize) m_Longs.size(), m_Longs.data());
+		jdoubleArray doubles = frame.NewDoubleArray((jsize) m_Doubles.size());
+		frame.SetDoubleArrayRegion(doubles, 0, (jsize) m_Doubles.size(), m_Doubles.data());
+		jobjectArray objects = frame.NewObjectArray((jsize) m_Objects.size(),
+				context->_java_lang_Object->getJavaClass(), NULL);
+
+		JPClass *objectClass = context->_java_lang_Object;
+		for (size_t i = 0; i < m_Objects.size(); ++i)
+		{
+			// Use a local frame so that large trees do not pile up references
+			JPJavaFrame inner = JPJavaFrame::inner(context);
+			PyObject *obj = m_Objects[i].get();
+			jobject value;
+			if (PyUnicode_CheckExact(obj))
+			{
+				value = inner.fromStringUTF8(JPPyString::asStringUTF8(obj));
+			} else
+			{
+				JPMatch match(&inner, obj);
+				if (objectClass->findJavaConversion(match) < JPMatch::_implicit)
+				{
+					PyErr_Format(PyExc_TypeError, "Unable to convert '%s' to Java",
+							Py_TYPE(obj)->tp_name);
+					JP_RAISE_PYTHON();
+				}
+				value = match.convert().l;
+			}
+			inner.SetObjectArrayElement(objects, (jsize) i, value);
+		}
+		return frame.buildCollection(codes, longs, doubles, objects);
+	}
+
+private:
+	std::vector<jbyte> m_Codes;
+	std::vector<jlong> m_Longs;
+	std::vector<jdouble> m_Doubles;
+	std::vector<JPPyObject> m_Objects;
+} ;
+
+class JPCollectionDecoder
+{
+public:
+
+	JPCollectionDecoder(JPJavaFrame& frame, jobjectArray parts)
+	: m_Frame(frame)
+	{
+		jbyteArray codes = (jbyteArray) frame.GetObjectArrayElement(parts, 0);
+		jlongArray longs = (jlongArray) frame.GetObjectArrayElement(parts, 1);
+		jdoubleArray doubles = (jdoubleArray) frame.GetObjectArrayElement(parts, 2);
+		m_Objects = (jobjectArray) frame.GetObjectArrayElement(parts, 3);
+		m_Codes.resize(frame.GetArrayLength(codes));
+		m_Longs.resize(frame.GetArrayLength(longs));
+		m_Doubles.resize(frame.GetArrayLength(doubles));
+		frame.GetByteArrayRegion(codes, 0, (jsize) m_Codes.size(), m_Codes.data());
+		frame.GetLongArrayRegion(longs, 0, (jsize) m_Longs.size(), m_Longs.data());
+		frame.GetDoubleArrayRegion(doubles, 0, (jsize) m_Doubles.size(), m_Doubles.data());
+		m_NextCode = 0;
+		m_NextLong = 0;
+		m_NextDouble = 0;
+		m_NextObject = 0;
+	}
+
+	JPPyObject next()
+	{
+		switch (m_Codes[m_NextCode++])
+		{
+			case CODE_NULL:
+				return JPPyObject::getNone();
+			case CODE_STRING:
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(m_Frame.getContext());
+				jstring str = (jstring) inner.GetObjectArrayElement(m_Objects, m_NextObject++);
+				return JPPyString::fromStringUTF8(inner.toStringUTF8(str));
+			}
+			case CODE_BOOLEAN:
+				return JPPyObject::call(PyBool_FromLong((long) m_Longs[m_NextLong++]));
+			case CODE_LONG:
+				return JPPyObject::call(PyLong_FromLongLong(m_Longs[m_NextLong++]));
+			case CODE_DOUBLE:
+				return JPPyObject::call(PyFloat_FromDouble(m_Doubles[m_NextDouble++]));
+			case CODE_MAP:
+			{
+				jlong n = m_Longs[m_NextLong++];
+				JPPyObject dict = JPPyObject::call(PyDict_New());
+				for (jlong i = 0; i < n; ++i)
+				{
+					JPPyObject key = next();
+					JPPyObject value = next();
+					if (PyDict_SetItem(dict.get(), key.get(), value.get()) == -1)
+						JP_RAISE_PYTHON();
+				}
+				return dict;
+			}
+			case CODE_LIST:
+			{
+				jlong n = m_Longs[m_NextLong++];
+				JPPyObject list = JPPyObject::call(PyList_New((Py_ssize_t) n));
+				for (jlong i = 0; i < n; ++i)
+				{
+					// PyList_SetItem steals the reference
+					PyList_SetItem(list.get(), (Py_ssize_t) i, next().keep());
+				}
+				return list;
+			}
+			case CODE_OBJECT:
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(m_Frame.getContext());
+				jvalue v;
+				v.l = inner.GetObjectArrayElement(m_Objects, m_NextObject++);
+				JPClass *cls = inner.findClassForObject(v.l);
+				return cls->convertToPythonObject(inner, v, false);
+			}
+		}
+		JP_RAISE(PyExc_SystemError, "bad collection code"); // GCOVR_EXCL_LINE
+	}
+
+private:
+	JPJavaFrame& m_Frame;
+	jobjectArray m_Objects;
+	std::vector<jbyte> m_Codes;
+	std::vector<jlong> m_Longs;
+	std::vector<jdouble> m_Doubles;
+	size_t m_NextCode;
+	size_t m_NextLong;
+	size_t m_NextDouble;
+	jsize m_NextObject;
+} ;
+
+}
+
+jobject JPCollections::toJava(JPJavaFrame& frame, PyObject* obj)
+{
+	JP_TRACE_IN("JPCollections::toJava");
+	JPCollectionEncoder encoder;
+	encoder.visit(obj, 0);
+	return encoder.build(frame);
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPCollections::toPython(JPJavaFrame& frame, jobject obj)
+{
+	JP_TRACE_IN("JPCollections::toPython");
+	JPCollectionDecoder decoder(frame, frame.flattenCollection(obj));
+	return decoder.next();
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPCollections::unbox(JPJavaFrame& frame, jobject obj, char type, bool mask)
+{
+	JP_TRACE_IN("JPCollections::unbox");
+	jobjectArray result = frame.unboxCollection(obj, (jchar) type, mask);
+	jarray values = (jarray) frame.GetObjectArrayElement(result, 0);
+	jsize n = frame.GetArrayLength(values);
+
+	// Copy the values straight into the storage of a bytearray
+	JPPyObject bytes = JPPyObject::call(PyByteArray_FromStringAndSize(NULL, (Py_ssize_t) n * 8));
+	char *data = PyByteArray_AsString(bytes.get());
+	const char *format;
+	if (frame.IsInstanceOf(values, frame.FindClass("[J")))
+	{
+		frame.GetLongArrayRegion((jlongArray) values, 0, n, (jlong*) data);
+		format = "q";
+	} else
+	{
+		frame.GetDoubleArrayRegion((jdoubleArray) values, 0, n, (jdouble*) data);
+		format = "d";
+	}
+	JPPyObject view = JPPyObject::call(PyMemoryView_FromObject(bytes.get()));
+	view = JPPyObject::call(PyObject_CallMethod(view.get(), "cast", "s", format));
+	if (!mask)
+		return view;
+
+	jbooleanArray nulls = (jbooleanArray) frame.GetObjectArrayElement(result, 1);
+	JPPyObject flags = JPPyObject::call(PyByteArray_FromStringAndSize(NULL, n));
+	frame.GetBooleanArrayRegion(nulls, 0, n, (jboolean*) PyByteArray_AsString(flags.get()));
+	JPPyObject flagView = JPPyObject::call(PyMemoryView_FromObject(flags.get()));
+	flagView = JPPyObject::call(PyObject_CallMethod(flagView.get(), "cast", "s", "?"));
+	return JPPyObject::call(PyTuple_Pack(2, view.get(), flagView.get()));
+	JP_TRACE_OUT;
+}
@@ -87,9 +87,9 @@ JPContext::JPContext()
 	m_Object_EqualsID = NULL;
 	m_Object_HashCodeID = NULL;
 	m_CallMethodID = NULL;
+	m_Context_VectorizeID = NULL;
 	m_Class_GetNameID = NULL;
 	m_Context_collectRectangularID = NULL;
-	m_Context_assembleID = NULL;
 	m_String_ToCharArrayID = NULL;
 	m_Context_CreateExceptionID = NULL;
 	m_Context_GetExcClassID = NULL;
@@ -100,7 +100,16 @@ JPContext::JPContext()
 	m_Object_GetClassID = NULL;
 	m_Throwable_GetCauseID = NULL;
 	m_Context_GetStackFrameID = NULL;
+	m_Collections_BuildID = NULL;
+	m_Collections_FlattenID = NULL;
+	m_Collections_UnboxID = NULL;
+	m_DataTypes_EncodeID = NULL;
 	m_Embedded = false;
+	m_AutoDetach = true;
+	m_ReuseThreads = false;
+	m_ThreadsAttached = 0;
+	m_ThreadAttaches = 0;
+	m_ThreadDetaches = 0;
 
 	m_GC = new JPGarbageCollection(this);
 }
@@ -305,14 +314,12 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 	// messages
 	m_CallMethodID = frame.GetMethodID(contextClass, "callMethod",
 			"(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;");
+	m_Context_VectorizeID = frame.GetMethodID(contextClass, "vectorize",
+			"(Ljava/lang/reflect/Method;[Ljava/lang/Object;IZ)Ljava/lang/Object;");
 	m_Context_collectRectangularID = frame.GetMethodID(contextClass,
 			"collectRectangular",
 			"(Ljava/lang/Object;)[Ljava/lang/Object;");
 
-	m_Context_assembleID = frame.GetMethodID(contextClass,
-			"assemble",
-			"([ILjava/lang/Object;)Ljava/lang/Object;");
-
 	m_Context_GetFunctionalID = frame.GetMethodID(contextClass,
 			"getFunctional",
 			"(Ljava/lang/Class;)Ljava/lang/String;");
@@ -333,6 +340,20 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 			"(Ljava/lang/String;)Ljava/lang/Object;");
 	m_Package_GetContentsID = frame.GetMethodID(packageClass, "getContents",
 			"()[Ljava/lang/String;");
+
+	jclass collectionsClass = m_ClassLoader->findClass(frame, "org.jpype.JPypeCollections");
+	m_CollectionsClass = JPClassRef(frame, collectionsClass);
+	m_Collections_BuildID = frame.GetStaticMethodID(collectionsClass, "build",
+			"([B[J[D[Ljava/lang/Object;)Ljava/lang/Object;");
+	m_Collections_FlattenID = frame.GetStaticMethodID(collectionsClass, "flatten",
+			"(Ljava/lang/Object;)[Ljava/lang/Object;");
+	m_Collections_UnboxID = frame.GetStaticMethodID(collectionsClass, "unbox",
+			"(Ljava/lang/Object;CZ)[Ljava/lang/Object;");
+
+	jclass dataTypesClass = m_ClassLoader->findClass(frame, "org.jpype.JPypeDataTypes");
+	m_DataTypesClass = JPClassRef(frame, dataTypesClass);
+	m_DataTypes_EncodeID = frame.GetStaticMethodID(dataTypesClass, "encode",
+			"([Ljava/lang/Object;)[Ljava/lang/Object;");
 	m_Context_NewWrapperID = frame.GetMethodID(contextClass, "newWrapper",
 			"(J)V");
 
@@ -428,20 +449,110 @@ void JPContext::ReleaseGlobalRef(jobject obj)
 /*****************************************************************************/
 // Thread code
 
+namespace
+{
+
+/**
+ * Tracks whether JPype attached the current thread.
+ *
+ * The destructor runs when the native thread exits, which lets us detach
+ * threads that were attached automatically and would otherwise leave a
+ * Java thread behind.
+ */
+class JPThreadAttachment
+{
+public:
+	JPContext *m_Context;
+	bool m_Automatic;
+
+	JPThreadAttachment() : m_Context(NULL), m_Automatic(false)
+	{
+	}
+
+	~JPThreadAttachment()
+	{
+		if (m_Context != NULL)
+			m_Context->onThreadExit(m_Automatic);
+	}
+} ;
+
+thread_local JPThreadAttachment jp_thread_attachment;
+
+}
+
+void JPContext::setThreadPolicy(bool autoDetach, bool reuse)
+{
+	m_AutoDetach = autoDetach;
+	m_ReuseThreads = reuse;
+}
+
+void JPContext::getThreadCounts(long long *counts)
+{
+	counts[0] = m_ThreadsAttached;
+	counts[1] = m_ThreadAttaches;
+	counts[2] = m_ThreadDetaches;
+}
+
+void JPContext::onThreadExit(bool automatic)
+{
+	// User threads are left for the user, and nothing can be done once the
+	// JVM is shutting down.
+	if (!automatic || !m_AutoDetach || !isRunning())
+		return;
+	m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+	m_ThreadsAttached--;
+	m_ThreadDetaches++;
+}
+
 void JPContext::attachCurrentThread()
 {
+	JPThreadAttachment &state = jp_thread_attachment;
+	// A reused daemon attachment must be released to change the kind
+	if (m_ReuseThreads && state.m_Automatic && isThreadAttached())
+	{
+		m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+		m_ThreadsAttached--;
+		m_ThreadDetaches++;
+		state.m_Context = NULL;
+	}
+	bool attached = isThreadAttached();
 	JNIEnv* env;
 	jint res = m_JavaVM->functions->AttachCurrentThread(m_JavaVM, (void**) &env, NULL);
 	if (res != JNI_OK)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread");
+	if (!attached)
+	{
+		m_ThreadsAttached++;
+		m_ThreadAttaches++;
+		state.m_Context = this;
+		state.m_Automatic = false;
+	} else if (state.m_Automatic)
+	{
+		// An explicit attach takes the thread over from the automatic one
+		state.m_Context = this;
+		state.m_Automatic = false;
+	}
 }
 
 void JPContext::attachCurrentThreadAsDaemon()
 {
+	JPThreadAttachment &state = jp_thread_attachment;
+	// Automatic attachments are already daemon so they are adopted as is
+	bool attached = isThreadAttached();
 	JNIEnv* env;
 	jint res = m_JavaVM->functions->AttachCurrentThreadAsDaemon(m_JavaVM, (void**) &env, NULL);
 	if (res != JNI_OK)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread as daemon");
+	if (!attached || state.m_Automatic)
+	{
+		if (!attached)
+		{
+			m_ThreadsAttached++;
+			m_ThreadAttaches++;
+		}
+		state.m_Context = this;
+		state.m_Automatic = false;
+	}
 }
 
 bool JPContext::isThreadAttached()
@@ -452,7 +563,23 @@ bool JPContext::isThreadAttached()
 
 void JPContext::detachCurrentThread()
 {
-	m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+	JPThreadAttachment &state = jp_thread_attachment;
+	// Pooled threads keep their automatic attachment until they exit
+	if (m_ReuseThreads && m_AutoDetach && state.m_Automatic)
+		return;
+	if (state.m_Context == NULL)
+	{
+		// Not attached by us, so there is nothing to count
+		m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+		return;
+	}
+	if (m_JavaVM->functions->DetachCurrentThread(m_JavaVM) == JNI_OK)
+	{
+		m_ThreadsAttached--;
+		m_ThreadDetaches++;
+	}
+	state.m_Context = NULL;
+	state.m_Automatic = false;
 }
 
 JNIEnv* JPContext::getEnv()
@@ -474,6 +601,10 @@ JNIEnv* JPContext::getEnv()
 		res = m_JavaVM->AttachCurrentThreadAsDaemon((void**) &env, NULL);
 		if (res != JNI_OK)
 			JP_RAISE(PyExc_RuntimeError, "Unable to attach to local thread");
+		m_ThreadsAttached++;
+		m_ThreadAttaches++;
+		jp_thread_attachment.m_Context = this;
+		jp_thread_attachment.m_Automatic = true;
 	}
 	return env;
 }
@@ -80,6 +80,149 @@ public:
 	}
 
 } ;
+
+/**
+ * Widen a half precision float to single precision.
+ *
+ * This is written without branches on the value class so that the bulk
+ * loops below can be vectorized by the compiler.
+ */
+inline float halfToFloat(uint16_t h)
+{
+	const uint32_t shifted = 0x7c00 << 13;
+	union
+	{
+		uint32_t u;
+		float f;
+	} o, magic;
+	magic.u = 113 << 23;
+	o.u = (uint32_t) (h & 0x7fff) << 13;
+	uint32_t exp = shifted & o.u;
+	o.u += (127 - 15) << 23;
+	if (exp == shifted)
+		o.u += (128 - 16) << 23; // Inf/NaN
+	else if (exp == 0)
+	{
+		// Zero/subnormal
+		o.u += 1 << 23;
+		o.f -= magic.f;
+	}
+	o.u |= (uint32_t) (h & 0x8000) << 16;
+	return o.f;
+}
+
+class ConvertHalf
+{
+public:
+
+	static jvalue toZ(void* c)
+	{
+		jvalue v;
+		v.z = halfToFloat(*(uint16_t*) c) != 0;
+		return v;
+	}
+
+	static jvalue toB(void* c)
+	{
+		jvalue v;
+		v.b = (jbyte) halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toC(void* c)
+	{
+		jvalue v;
+		v.c = (jchar) halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toS(void* c)
+	{
+		jvalue v;
+		v.s = (jshort) halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toI(void* c)
+	{
+		jvalue v;
+		v.i = (jint) halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toJ(void* c)
+	{
+		jvalue v;
+		v.j = (jlong) halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toF(void* c)
+	{
+		jvalue v;
+		v.f = halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+	static jvalue toD(void* c)
+	{
+		jvalue v;
+		v.d = halfToFloat(*(uint16_t*) c);
+		return v;
+	}
+
+} ;
+
+/**
+ * Bulk kernels for contiguous sources.
+ *
+ * These are plain loops over restricted pointers so that the compiler can
+ * emit packed widening instructions.
+ */
+template <class S, class D>
+class Widen
+{
+public:
+
+	static void run(void* dest, void* src, jsize n)
+	{
+		D* __restrict d = (D*) dest;
+		const S* __restrict s = (const S*) src;
+		for (jsize i = 0; i < n; ++i)
+			d[i] = (D) s[i];
+	}
+} ;
+
+template <class D>
+class WidenHalf
+{
+public:
+
+	static void run(void* dest, void* src, jsize n)
+	{
+		D* __restrict d = (D*) dest;
+		const uint16_t* __restrict s = (const uint16_t*) src;
+		for (jsize i = 0; i < n; ++i)
+			d[i] = (D) halfToFloat(s[i]);
+	}
+} ;
+
+template <class S>
+jbulkconverter getWiden(const char* to)
+{
+	switch (to[0])
+	{
+		case 'b': return &Widen<S, jbyte>::run;
+		case 'c': return &Widen<S, jchar>::run;
+		case 's': return &Widen<S, jshort>::run;
+		case 'i': return &Widen<S, jint>::run;
+		case 'j': return &Widen<S, jlong>::run;
+		case 'f': return &Widen<S, jfloat>::run;
+		case 'd': return &Widen<S, jdouble>::run;
+	}
+	return 0;
+}
+
 } // namespace
 
 jconverter getConverter(const char* from, int itemsize, const char* to)
@@ -228,9 +371,60 @@ jconverter getConverter(const char* from, int itemsize, const char* to)
 				case 'd': return &Convert<double>::toD;
 			}
 			return 0;
+		case 'e':
+			switch (to[0])
+			{
+				case 'z': return &ConvertHalf::toZ;
+				case 'b': return &ConvertHalf::toB;
+				case 'c': return &ConvertHalf::toC;
+				case 's': return &ConvertHalf::toS;
+				case 'i': return &ConvertHalf::toI;
+				case 'j': return &ConvertHalf::toJ;
+				case 'f': return &ConvertHalf::toF;
+				case 'd': return &ConvertHalf::toD;
+			}
+			return 0;
 		case 'n':
 		case 'N':
 		case 'P':
 		default: return 0;
 	}
 }
+
+jbulkconverter getBulkConverter(const char* from, int itemsize, const char* to)
+{
+	if (from == NULL)
+		from = "B";
+	if (itemsize == 8 && from[0] == 'l')
+		from = "q";
+	if (itemsize == 8 && from[0] == 'L')
+		from = "Q";
+	// Boolean requires a test rather than a cast so it stays element-wise.
+	if (to[0] == 'z')
+		return 0;
+	switch (from[0])
+	{
+		case 'c':
+		case 'b': return getWiden<int8_t>(to);
+		case 'B': return getWiden<uint8_t>(to);
+		case 'h': return getWiden<int16_t>(to);
+		case 'H': return getWiden<uint16_t>(to);
+		case 'i':
+		case 'l': return getWiden<int32_t>(to);
+		case 'I':
+		case 'L': return getWiden<uint32_t>(to);
+		case 'q': return getWiden<int64_t>(to);
+		// Only reached with an explicit dtype, as there is no wider Java type
+		case 'Q': return getWiden<uint64_t>(to);
+		case 'f': return getWiden<float>(to);
+		case 'd': return getWiden<double>(to);
+		case 'e':
+			switch (to[0])
+			{
+				case 'f': return &WidenHalf<jfloat>::run;
+				case 'd': return &WidenHalf<jdouble>::run;
+			}
+			return 0;
+		default: return 0;
+	}
+}
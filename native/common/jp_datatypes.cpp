@@ -0,0 +1,324 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include <Python.h>
+#include <datetime.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_datatypes.h"
+
+namespace
+{
+
+// Must match org.jpype.JPypeDataTypes
+enum
+{
+	KIND_NULL = 0,
+	KIND_DATE = 1,
+	KIND_TIME = 2,
+	KIND_DATETIME = 3,
+	KIND_INSTANT = 4,
+	KIND_OFFSET = 5,
+	KIND_DECIMAL = 6,
+	KIND_DECIMAL_STRING = 7,
+	KIND_OTHER = 8,
+	KIND_ZONED = 9
+} ;
+
+const jlong MICROS_PER_DAY = 86400000000LL;
+
+PyObject *s_Timezone = NULL;
+PyObject *s_UTC = NULL;
+PyObject *s_Decimal = NULL;
+PyObject *s_ZoneInfo = NULL;
+std::atomic<bool> s_Ready(false);
+std::map<jlong, PyObject*> s_Offsets;
+std::map<std::string, PyObject*> s_Zones;
+
+// Guards the globals above.  Python is never called while it is held, as
+// that could wait on a thread that is waiting for this lock.
+std::mutex s_Lock;
+
+void initialize()
+{
+	if (s_Ready.load(std::memory_order_acquire))
+		return;
+	void *api = PyCapsule_Import(PyDateTime_CAPSULE_NAME, 0);
+	JP_PY_CHECK();
+	JPPyObject datetime = JPPyObject::call(PyImport_ImportModule("datetime"));
+	JPPyObject decimal = JPPyObject::call(PyImport_ImportModule("decimal"));
+	JPPyObject timezone = JPPyObject::call(PyObject_GetAttrString(datetime.get(), "timezone"));
+	JPPyObject utc = JPPyObject::call(PyObject_GetAttrString(timezone.get(), "utc"));
+	JPPyObject decimalType = JPPyObject::call(PyObject_GetAttrString(decimal.get(), "Decimal"));
+	// zoneinfo is only available from Python 3.9
+	JPPyObject zoneInfo;
+	JPPyObject zoneinfo = JPPyObject::accept(PyImport_ImportModule("zoneinfo"));
+	if (zoneinfo.isNull())
+		PyErr_Clear();
+	else
+	{
+		zoneInfo = JPPyObject::accept(PyObject_GetAttrString(zoneinfo.get(), "ZoneInfo"));
+		if (zoneInfo.isNull())
+			PyErr_Clear();
+	}
+
+	// Threads that lose the race release what they looked up
+	std::lock_guard<std::mutex> guard(s_Lock);
+	if (s_Ready.load(std::memory_order_relaxed))
+		return;
+	PyDateTimeAPI = (PyDateTime_CAPI*) api;
+	s_Timezone = timezone.keep();
+	s_UTC = utc.keep();
+	s_Decimal = decimalType.keep();
+	s_ZoneInfo = zoneInfo.isNull() ? NULL : zoneInfo.keep();
+	s_Ready.store(true, std::memory_order_release);
+}
+
+/** Convert days since 1970-01-01 to a civil date.
+ *
+ * Algorithm from Howard Hinnant's chrono date library.
+ */
+void civilFromDays(jlong z, int& y, int& m, int& d)
+{
+	z += 719468;
+	jlong era = (z >= 0 ? z : z - 146096) / 146097;
+	jlong doe = z - era * 146097;
+	jlong yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	jlong doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	jlong mp = (5 * doy + 2) / 153;
+	d = (int) (doy - (153 * mp + 2) / 5 + 1);
+	m = (int) (mp < 10 ? mp + 3 : mp - 9);
+	y = (int) (yoe + era * 400 + (m <= 2));
+}
+
+JPPyObject toDateTime(jlong micros, PyObject* tz)
+{
+	jlong days = micros / MICROS_PER_DAY;
+	jlong rem = micros % MICROS_PER_DAY;
+	if (rem < 0)
+	{
+		rem += MICROS_PER_DAY;
+		days--;
+	}
+	int y, m, d;
+	civilFromDays(days, y, m, d);
+	jlong secs = rem / 1000000;
+	return JPPyObject::call(PyDateTimeAPI->DateTime_FromDateAndTime(y, m, d,
+			(int) (secs / 3600), (int) (secs / 60 % 60), (int) (secs % 60),
+			(int) (rem % 1000000), tz, PyDateTimeAPI->DateTimeType));
+}
+
+JPPyObject toTimezone(jlong offset)
+{
+	{
+		std::lock_guard<std::mutex> guard(s_Lock);
+		std::map<jlong, PyObject*>::iterator iter = s_Offsets.find(offset);
+		if (iter != s_Offsets.end())
+			return JPPyObject::use(iter->second);
+	}
+	JPPyObject delta = JPPyObject::call(PyDelta_FromDSU(0, (int) offset, 0));
+	JPPyObject tz = JPPyObject::call(PyObject_CallFunctionObjArgs(s_Timezone, delta.get(), NULL));
+	// Offsets in use are few, so they are kept for the life of the module
+	std::lock_guard<std::mutex> guard(s_Lock);
+	PyObject *&entry = s_Offsets[offset];
+	if (entry == NULL)
+		entry = tz.keep();
+	return JPPyObject::use(entry);
+}
+
+/** Get the zoneinfo zone for a Java region id.
+ *
+ * @return the zone, or null if zoneinfo is missing or does not know the id.
+ */
+JPPyObject toZone(const std::string& id)
+{
+	{
+		std::lock_guard<std::mutex> guard(s_Lock);
+		std::map<std::string, PyObject*>::iterator iter = s_Zones.find(id);
+		if (iter != s_Zones.end())
+		{
+			if (iter->second == Py_None)
+				return JPPyObject();
+			return JPPyObject::use(iter->second);
+		}
+	}
+	JPPyObject zone;
+	if (s_ZoneInfo != NULL)
+	{
+		zone = JPPyObject::accept(PyObject_CallFunction(s_ZoneInfo, "s", id.c_str()));
+		if (zone.isNull())
+			PyErr_Clear();
+	}
+	// Misses are cached as None so the lookup is only tried once
+	if (zone.isNull())
+		zone = JPPyObject::getNone();
+	std::lock_guard<std::mutex> guard(s_Lock);
+	PyObject *&entry = s_Zones[id];
+	if (entry == NULL)
+		entry = zone.keep();
+	if (entry == Py_None)
+		return JPPyObject();
+	return JPPyObject::use(entry);
+}
+
+JPPyObject toZonedDateTime(jlong micros, jlong offset, const std::string& id)
+{
+	JPPyObject zone = toZone(id);
+	if (zone.isNull())
+		return toDateTime(micros, toTimezone(offset).get());
+	// Going through UTC picks the right fold for repeated local times
+	JPPyObject utc = toDateTime(micros - offset * 1000000, zone.get());
+	return JPPyObject::call(PyObject_CallMethod(zone.get(), "fromutc", "O", utc.get()));
+}
+
+JPPyObject toDecimal(bool negative, const std::string& digits, jlong scale)
+{
+	JPPyObject tuple = JPPyObject::call(PyTuple_New((Py_ssize_t) digits.size()));
+	for (size_t i = 0; i < digits.size(); ++i)
+		PyTuple_SetItem(tuple.get(), (Py_ssize_t) i, PyLong_FromLong(digits[i] - '0'));
+	JPPyObject args = JPPyObject::call(Py_BuildValue("((iOL))", negative ? 1 : 0, tuple.get(), (long long) - scale));
+	return JPPyObject::call(PyObject_Call(s_Decimal, args.get(), NULL));
+}
+
+class JPDataTypesDecoder
+{
+public:
+
+	JPDataTypesDecoder(JPJavaFrame& frame, jobjectArray values)
+	: m_Frame(frame)
+	{
+		jobjectArray parts = frame.encodeDataTypes(values);
+		jbyteArray kinds = (jbyteArray) frame.GetObjectArrayElement(parts, 0);
+		jlongArray data = (jlongArray) frame.GetObjectArrayElement(parts, 1);
+		m_Strings = (jobjectArray) frame.GetObjectArrayElement(parts, 2);
+		m_Values = values;
+		m_Kinds.resize(frame.GetArrayLength(kinds));
+		m_Data.resize(frame.GetArrayLength(data));
+		frame.GetByteArrayRegion(kinds, 0, (jsize) m_Kinds.size(), m_Kinds.data());
+		frame.GetLongArrayRegion(data, 0, (jsize) m_Data.size(), m_Data.data());
+	}
+
+	size_t size() const
+	{
+		return m_Kinds.size();
+	}
+
+	JPPyObject get(jsize i)
+	{
+		jlong v0 = m_Data[2 * i];
+		jlong v1 = m_Data[2 * i + 1];
+		switch (m_Kinds[i])
+		{
+			case KIND_NULL:
+				return JPPyObject::getNone();
+			case KIND_DATE:
+			{
+				int y, m, d;
+				civilFromDays(v0, y, m, d);
+				return JPPyObject::call(PyDate_FromDate(y, m, d));
+			}
+			case KIND_TIME:
+			{
+				jlong secs = v0 / 1000000;
+				return JPPyObject::call(PyTime_FromTime((int) (secs / 3600),
+						(int) (secs / 60 % 60), (int) (secs % 60), (int) (v0 % 1000000)));
+			}
+			case KIND_DATETIME:
+				return toDateTime(v0, Py_None);
+			case KIND_INSTANT:
+				return toDateTime(v0, s_UTC);
+			case KIND_OFFSET:
+				return toDateTime(v0, toTimezone(v1).get());
+			case KIND_DECIMAL:
+			{
+				// Negate as unsigned so that the minimum long is handled
+				unsigned long long mag = v0 < 0 ? 0ULL - (unsigned long long) v0 : (unsigned long long) v0;
+				return toDecimal(v0 < 0, std::to_string(mag), v1);
+			}
+			case KIND_ZONED:
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(m_Frame.getContext());
+				jstring str = (jstring) inner.GetObjectArrayElement(m_Strings, (jsize) (v1 >> 32));
+				return toZonedDateTime(v0, (jint) (v1 & 0xffffffff), inner.toStringUTF8(str));
+			}
+			case KIND_DECIMAL_STRING:
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(m_Frame.getContext());
+				jstring str = (jstring) inner.GetObjectArrayElement(m_Strings, (jsize) v0);
+				std::string digits = inner.toStringUTF8(str);
+				bool negative = digits[0] == '-';
+				return toDecimal(negative, negative ? digits.substr(1) : digits, v1);
+			}
+			default:
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(m_Frame.getContext());
+				jvalue v;
+				v.l = inner.GetObjectArrayElement(m_Values, i);
+				JPClass *cls = inner.findClassForObject(v.l);
+				return cls->convertToPythonObject(inner, v, false);
+			}
+		}
+	}
+
+private:
+	JPJavaFrame& m_Frame;
+	jobjectArray m_Values;
+	jobjectArray m_Strings;
+	std::vector<jbyte> m_Kinds;
+	std::vector<jlong> m_Data;
+} ;
+
+}
+
+JPPyObject JPDataTypes::toPython(JPJavaFrame& frame, jobject obj)
+{
+	JP_TRACE_IN("JPDataTypes::toPython");
+	initialize();
+	JPContext *context = frame.getContext();
+	jobjectArray values = frame.NewObjectArray(1, context->_java_lang_Object->getJavaClass(), obj);
+	JPDataTypesDecoder decoder(frame, values);
+	return decoder.get(0);
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPDataTypes::toPythonList(JPJavaFrame& frame, PyObject* seq)
+{
+	JP_TRACE_IN("JPDataTypes::toPythonList");
+	initialize();
+	JPContext *context = frame.getContext();
+	JPPySequence items = JPPySequence::use(seq);
+	jsize n = (jsize) items.size();
+	jobjectArray values = frame.NewObjectArray(n, context->_java_lang_Object->getJavaClass(), NULL);
+	for (jsize i = 0; i < n; ++i)
+	{
+		JPPyObject item = items[i];
+		if (item.get() == Py_None)
+			continue;
+		JPValue *value = PyJPValue_getJavaSlot(item.get());
+		if (value == NULL || value->getClass()->isPrimitive())
+			JP_RAISE(PyExc_TypeError, "Java object is required");
+		frame.SetObjectArrayElement(values, i, value->getValue().l);
+	}
+
+	JPDataTypesDecoder decoder(frame, values);
+	JPPyObject out = JPPyObject::call(PyList_New(n));
+	for (jsize i = 0; i < n; ++i)
+		PyList_SetItem(out.get(), i, decoder.get(i).keep());
+	return out;
+	JP_TRACE_OUT;
+}
@@ -30,42 +30,66 @@ JPField::JPField(JPJavaFrame& frame,
 	m_FieldID = fid;
 	m_Type = fieldType;
 	m_Modifiers = modifiers;
+	m_TypeCode = 0;
+	if (fieldType != NULL && fieldType->isPrimitive())
+		m_TypeCode = ((JPPrimitiveType*) fieldType)->getTypeCode();
 }
 
 JPField::~JPField()
 {
 }
 
-JPPyObject JPField::getStaticField()
+JPPyObject JPField::getStaticField(JPJavaFrame& frame)
 {
 	JP_TRACE_IN("JPField::getStaticAttribute");
-	JPJavaFrame frame = JPJavaFrame::outer(m_Class->getContext());
 	return m_Type->getStaticField(frame, m_Class->getJavaClass(), m_FieldID);
 	JP_TRACE_OUT;
 }
 
-void JPField::setStaticField(PyObject *pyobj)
+void JPField::setStaticField(JPJavaFrame& frame, PyObject *pyobj)
 {
 	JP_TRACE_IN("JPField::setStaticAttribute");
-	JPJavaFrame frame = JPJavaFrame::outer(m_Class->getContext());
 	m_Type->setStaticField(frame, m_Class->getJavaClass(), m_FieldID, pyobj);
 	JP_TRACE_OUT;
 }
 
-JPPyObject JPField::getField(jobject inst)
+JPPyObject JPField::getField(JPJavaFrame& frame, jobject inst)
 {
 	JP_TRACE_IN("JPField::getAttribute");
-	JPJavaFrame frame = JPJavaFrame::outer(m_Class->getContext());
 	ASSERT_NOT_NULL(m_Type);
 	JP_TRACE("field type", m_Type->getCanonicalName());
 	return m_Type->getField(frame, inst, m_FieldID);
 	JP_TRACE_OUT;
 }
 
-void JPField::setField(jobject inst, PyObject *pyobj)
+void JPField::setField(JPJavaFrame& frame, jobject inst, PyObject *pyobj)
 {
 	JP_TRACE_IN("JPField::setAttribute");
-	JPJavaFrame frame = JPJavaFrame::outer(m_Class->getContext());
 	m_Type->setField(frame, inst, m_FieldID, pyobj);
 	JP_TRACE_OUT;
 }
+
+JPPyObject JPField::getPlainField(JPJavaFrame& frame, jobject inst)
+{
+	switch (m_TypeCode)
+	{
+		case 'Z':
+			return JPPyObject::call(PyBool_FromLong(frame.GetBooleanField(inst, m_FieldID)));
+		case 'B':
+			return JPPyObject::call(PyLong_FromLong(frame.GetByteField(inst, m_FieldID)));
+		case 'C':
+			return JPPyObject::call(PyUnicode_FromOrdinal(frame.GetCharField(inst, m_FieldID)));
+		case 'S':
+			return JPPyObject::call(PyLong_FromLong(frame.GetShortField(inst, m_FieldID)));
+		case 'I':
+			return JPPyObject::call(PyLong_FromLong(frame.GetIntField(inst, m_FieldID)));
+		case 'J':
+			return JPPyObject::call(PyLong_FromLongLong(frame.GetLongField(inst, m_FieldID)));
+		case 'F':
+			return JPPyObject::call(PyFloat_FromDouble(frame.GetFloatField(inst, m_FieldID)));
+		case 'D':
+			return JPPyObject::call(PyFloat_FromDouble(frame.GetDoubleField(inst, m_FieldID)));
+		default:
+			return getField(frame, inst);
+	}
+}
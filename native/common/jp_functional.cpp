@@ -32,6 +32,29 @@ JPFunctional::~JPFunctional()
 {
 }
 
+jobject JPFunctional::findProxy(JPJavaFrame& frame, PyObject *callable)
+{
+	std::lock_guard<std::mutex> guard(m_ProxiesLock);
+	std::map<PyObject*, PyJPProxy*>::iterator iter = m_Proxies.find(callable);
+	if (iter == m_Proxies.end())
+		return NULL;
+	return iter->second->m_Proxy->findInstance(frame);
+}
+
+void JPFunctional::addProxy(PyObject *callable, PyJPProxy *proxy)
+{
+	std::lock_guard<std::mutex> guard(m_ProxiesLock);
+	m_Proxies[callable] = proxy;
+}
+
+void JPFunctional::removeProxy(PyObject *callable, PyJPProxy *proxy)
+{
+	std::lock_guard<std::mutex> guard(m_ProxiesLock);
+	std::map<PyObject*, PyJPProxy*>::iterator iter = m_Proxies.find(callable);
+	if (iter != m_Proxies.end() && iter->second == proxy)
+		m_Proxies.erase(iter);
+}
+
 class JPConversionFunctional : public JPConversion
 {
 public:
@@ -58,16 +81,30 @@ public:
 		JP_TRACE_IN("JPConversionFunctional::convert");
 		JPContext *context = PyJPModule_getContext();
 		JPJavaFrame frame = JPJavaFrame::inner(context);
+
+		// Reuse the proxy if this callable was already passed
+		jvalue v;
+		v.l = cls->findProxy(frame, match.object);
+		if (v.l != NULL)
+		{
+			JP_STAT_INC(JPStat_proxyCacheHits);
+			v.l = frame.keep(v.l);
+			return v;
+		}
+		JP_STAT_INC(JPStat_proxyCacheMisses);
+
 		PyJPProxy *self = (PyJPProxy*) PyJPProxy_Type->tp_alloc(PyJPProxy_Type, 0);
 		JP_PY_CHECK();
 		JPClassList cl;
 		cl.push_back(cls);
-		self->m_Proxy = new JPProxyFunctional(context, self, cl);
+		JPProxyFunctional *proxy = new JPProxyFunctional(context, self, cl);
+		self->m_Proxy = proxy;
 		self->m_Target = match.object;
 		self->m_Convert = true;
 		Py_INCREF(match.object);
-		jvalue v = self->m_Proxy->getProxy();
+		v = self->m_Proxy->getProxy();
 		v.l = frame.keep(v.l);
+		proxy->addToCache(match.object);
 		Py_DECREF(self);
 		return v;
 		JP_TRACE_OUT;  // GCOVR_EXCL_LINE
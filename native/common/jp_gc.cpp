@@ -98,10 +98,9 @@ void triggerPythonGC();
 void JPGarbageCollection::triggered()
 {
 	// If we were triggered from Java call a Python cleanup
-	if (!in_python_gc)
+	if (!in_python_gc.exchange(true))
 	{
 		// trigger Python gc
-		in_python_gc = true;
 		java_triggered = true;
 		java_count++;
 
@@ -174,7 +173,10 @@ void JPGarbageCollection::onStart()
 	// coverage just creates random statistics.
 	if (!running)
 		return;
-	getWorkingSize();
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		getWorkingSize();
+	}
 	in_python_gc = true;
 	// GCOVR_EXCL_STOP
 }
@@ -192,72 +194,84 @@ void JPGarbageCollection::onEnd()
 		java_triggered = false;
 		return;
 	}
-	if (in_python_gc)
+	if (in_python_gc.exchange(false))
 	{
-		in_python_gc = false;
 		python_count++;
-		int run_gc = 0;
-
-		size_t current = getWorkingSize();
-		if (current > high_water)
-			high_water = current;
-		if (current < low_water)
-			low_water = current;
-
-		if (java_triggered)
-			last_java = current;
-		else
-			last_python = current;
-
-		// Things are getting better so use high water as limit
-		if (current == low_water)
-		{
-			limit = (limit + high_water) / 2;
-			if ( high_water > low_water + 4 * DELTA_LIMIT)
-				high_water = low_water + 4 * DELTA_LIMIT;
-		}
-
-		if (last_python > current)
-			last_python = current;
-
-		if (current < last)
-		{
-			last = current;
+		if (!decide())
 			return;
-		}
 
-		// Decide the policy
-		if (current > limit)
-		{
-			limit = high_water + DELTA_LIMIT;
-			run_gc = 1;
-		}
+		// Don't reset the limit if it was count triggered
+		JPJavaFrame frame = JPJavaFrame::outer(m_Context);
+		frame.CallStaticVoidMethodA(_SystemClass, _gcMethodID, 0);
+		python_triggered++;
+	}
+	// GCOVR_EXCL_STOP
+}
+
+bool JPGarbageCollection::decide()
+{
+	// GCOVR_EXCL_START
+	std::lock_guard<std::mutex> guard(lock);
+	int run_gc = 0;
+
+	size_t current = getWorkingSize();
+	if (current > high_water)
+		high_water = current;
+	if (current < low_water)
+		low_water = current;
+
+	if (java_triggered)
+		last_java = current;
+	else
+		last_python = current;
+
+	// Things are getting better so use high water as limit
+	if (current == low_water)
+	{
+		limit = (limit + high_water) / 2;
+		if ( high_water > low_water + 4 * DELTA_LIMIT)
+			high_water = low_water + 4 * DELTA_LIMIT;
+	}
+
+	if (last_python > current)
+		last_python = current;
 
-		// Predict if we will cross the limit soon.
-		ssize_t pred = current + 2 * (current - last);
+	if (current < last)
+	{
 		last = current;
-		if ((ssize_t) pred > (ssize_t) limit)
-			run_gc = 2;
-
-		//		printf("consider gc %d (%ld, %ld, %ld, %ld) %ld\n", run_gc,
-		//				current, low_water, high_water, limit, limit - pred);
-
-		if (run_gc > 0)
-		{
-			// Move up the low water
-			low_water = (low_water + high_water) / 2;
-			// Don't reset the limit if it was count triggered
-			JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-			frame.CallStaticVoidMethodA(_SystemClass, _gcMethodID, 0);
-			python_triggered++;
-		}
+		return false;
+	}
+
+	// Decide the policy
+	if (current > limit)
+	{
+		limit = high_water + DELTA_LIMIT;
+		run_gc = 1;
+	}
+
+	// Predict if we will cross the limit soon.
+	ssize_t pred = current + 2 * (current - last);
+	last = current;
+	if ((ssize_t) pred > (ssize_t) limit)
+		run_gc = 2;
+
+	//		printf("consider gc %d (%ld, %ld, %ld, %ld) %ld\n", run_gc,
+	//				current, low_water, high_water, limit, limit - pred);
+
+	if (run_gc > 0)
+	{
+		// Move up the low water
+		low_water = (low_water + high_water) / 2;
+		return true;
 	}
+	return false;
 	// GCOVR_EXCL_STOP
 }
 
 void JPGarbageCollection::getStats(JPGCStats& stats)
 {
 	// GCOVR_EXCL_START
+	std::lock_guard<std::mutex> guard(lock);
 	stats.current_rss = getWorkingSize();
 	stats.min_rss = low_water;
 	stats.max_rss = high_water;
@@ -193,36 +193,13 @@ void JPIntType::setArrayRange(JPJavaFrame& frame, jarray a,
 		PyObject* sequence)
 {
 	JP_TRACE_IN("JPIntType::setArrayRange");
-	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
-			&JPJavaFrame::GetIntArrayElements, &JPJavaFrame::ReleaseIntArrayElements);
-
-	type_t* val = accessor.get();
 	// First check if assigning sequence supports buffer API
 	if (PyObject_CheckBuffer(sequence))
 	{
 		JPPyBuffer buffer(sequence, PyBUF_FULL_RO);
 		if (buffer.valid())
 		{
-			Py_buffer& view = buffer.getView();
-			if (view.ndim != 1)
-				JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
-			Py_ssize_t vshape = view.shape[0];
-			Py_ssize_t vstep = view.strides[0];
-			if (vshape != length)
-				JP_RAISE(PyExc_ValueError, "mismatched size");
-
-			char* memory = (char*) view.buf;
-			if (view.suboffsets && view.suboffsets[0] >= 0)
-				memory = *((char**) memory) + view.suboffsets[0];
-			jsize index = start;
-			jconverter conv = getConverter(view.format, (int) view.itemsize, "i");
-			for (Py_ssize_t i = 0; i < length; ++i, index += step)
-			{
-				jvalue r = conv(memory);
-				val[index] = r.i;
-				memory += vstep;
-			}
-			accessor.commit();
+			setArrayFromBuffer<JPIntType>(frame, a, start, length, step, buffer, "i");
 			return;
 		} else
 		{
@@ -230,6 +207,10 @@ void JPIntType::setArrayRange(JPJavaFrame& frame, jarray a,
 		}
 	}
 
+	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
+			&JPJavaFrame::GetIntArrayElements, &JPJavaFrame::ReleaseIntArrayElements);
+
+	type_t* val = accessor.get();
 	// Use sequence API
 	JPPySequence seq = JPPySequence::use(sequence);
 	jsize index = start;
@@ -315,11 +296,11 @@ static void pack(jint* d, jvalue v)
 	*d = v.i;
 }
 
-PyObject *JPIntType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
+PyObject *JPIntType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base)
 {
 	JP_TRACE_IN("JPIntType::newMultiArray");
 	return convertMultiArray<type_t>(
 			frame, this, &pack, "i",
-			buffer, subs, base, dims);
+			buffer, subs, base);
 	JP_TRACE_OUT;
 }
@@ -42,6 +42,7 @@ JPJavaFrame::JPJavaFrame(JPContext* context, JNIEnv* p_env, int size, bool outer
 
 	// Create a memory management frame to live in
 	m_Env->PushLocalFrame(size);
+	JP_STAT_INC(JPStat_frames);
 	JP_TRACE_JAVA("JavaFrame", (jobject) - 1);
 }
 
@@ -50,6 +51,7 @@ JPJavaFrame::JPJavaFrame(const JPJavaFrame& frame)
 {
 	// Create a memory management frame to live in
 	m_Env->PushLocalFrame(LOCAL_FRAME_DEFAULT);
+	JP_STAT_INC(JPStat_frames);
 	JP_TRACE_JAVA("JavaFrame (copy)", (jobject) - 1);
 }
 
@@ -119,6 +121,7 @@ jobject JPJavaFrame::NewLocalRef(jobject obj)
 jobject JPJavaFrame::NewGlobalRef(jobject obj)
 {
 	JP_TRACE_JAVA("New Global", obj);
+	JP_STAT_INC(JPStat_globalRefs);
 	obj = m_Env->NewGlobalRef(obj);
 	JP_TRACE_JAVA("Global", obj);
 	return obj;
@@ -1128,17 +1131,49 @@ jobject JPJavaFrame::collectRectangular(jarray obj)
 			m_Context->m_Context_collectRectangularID, &v));
 }
 
-jobject JPJavaFrame::assemble(jobject dims, jobject parts)
+jobject JPJavaFrame::buildCollection(jbyteArray codes, jlongArray longs, jdoubleArray doubles, jobjectArray objects)
 {
-	if (m_Context->m_Context_collectRectangularID == 0)
-		return 0;
-	jvalue v[2];
-	v[0].l = (jobject) dims;
-	v[1].l = (jobject) parts;
-	JAVA_RETURN(jobject, "JPJavaFrame::assemble",
-			CallObjectMethodA(
-			m_Context->m_JavaContext.get(),
-			m_Context->m_Context_assembleID, v));
+	jvalue v[4];
+	v[0].l = (jobject) codes;
+	v[1].l = (jobject) longs;
+	v[2].l = (jobject) doubles;
+	v[3].l = (jobject) objects;
+	JAVA_RETURN(jobject, "JPJavaFrame::buildCollection",
+			CallStaticObjectMethodA(
+			m_Context->m_CollectionsClass.get(),
+			m_Context->m_Collections_BuildID, v));
+}
+
+jobjectArray JPJavaFrame::flattenCollection(jobject obj)
+{
+	jvalue v;
+	v.l = obj;
+	JAVA_RETURN(jobjectArray, "JPJavaFrame::flattenCollection",
+			(jobjectArray) CallStaticObjectMethodA(
+			m_Context->m_CollectionsClass.get(),
+			m_Context->m_Collections_FlattenID, &v));
+}
+
+jobjectArray JPJavaFrame::unboxCollection(jobject obj, jchar type, jboolean mask)
+{
+	jvalue v[3];
+	v[0].l = obj;
+	v[1].c = type;
+	v[2].z = mask;
+	JAVA_RETURN(jobjectArray, "JPJavaFrame::unboxCollection",
+			(jobjectArray) CallStaticObjectMethodA(
+			m_Context->m_CollectionsClass.get(),
+			m_Context->m_Collections_UnboxID, v));
+}
+
+jobjectArray JPJavaFrame::encodeDataTypes(jobjectArray values)
+{
+	jvalue v;
+	v.l = values;
+	JAVA_RETURN(jobjectArray, "JPJavaFrame::encodeDataTypes",
+			(jobjectArray) CallStaticObjectMethodA(
+			m_Context->m_DataTypesClass.get(),
+			m_Context->m_DataTypes_EncodeID, &v));
 }
 
 jobject JPJavaFrame::newArrayInstance(jclass c, jintArray dims)
@@ -1166,6 +1201,19 @@ jobject JPJavaFrame::callMethod(jobject method, jobject obj, jobject args)
 	JP_TRACE_OUT;
 }
 
+jobject JPJavaFrame::vectorize(jobject method, jobject args, jint n, jboolean parallel)
+{
+	JP_TRACE_IN("JPJavaFrame::vectorize");
+	JPJavaFrame frame(*this);
+	jvalue v[4];
+	v[0].l = method;
+	v[1].l = args;
+	v[2].i = n;
+	v[3].z = parallel;
+	return frame.keep(frame.CallObjectMethodA(m_Context->m_JavaContext.get(), m_Context->m_Context_VectorizeID, v));
+	JP_TRACE_OUT;
+}
+
 string JPJavaFrame::getFunctional(jclass c)
 {
 	jvalue v;
@@ -19,6 +19,12 @@
 #include "jp_method.h"
 #include "pyjp.h"
 
+std::atomic<int> _jp_gil_adaptive(0);
+std::atomic<long long> _jp_gil_threshold(2000);
+
+// Number of short calls before a method keeps the GIL
+static const int JP_GIL_SAMPLES = 16;
+
 JPMethod::JPMethod(JPJavaFrame& frame,
 		JPClass* claz,
 		const string& name,
@@ -34,6 +40,10 @@ JPMethod::JPMethod(JPJavaFrame& frame,
 	m_MoreSpecificOverloads = moreSpecific;
 	m_Modifiers = modifiers;
 	m_ReturnType = (JPClass*) (-1);
+	m_GILPolicy = _gilDefault;
+	m_GILSamples = 0;
+	m_GILShort = false;
+	m_TypeCacheReady = false;
 }
 
 JPMethod::~JPMethod()
@@ -44,8 +54,13 @@ void JPMethod::setParameters(
 		JPClass *returnType,
 		JPClassList parameterTypes)
 {
+	// The type manager serializes population, so only a repeated request
+	// from a thread that lost the race reaches here after the cache is set.
+	if (m_TypeCacheReady.load(std::memory_order_acquire))
+		return;
 	m_ReturnType = returnType;
 	m_ParameterTypes = parameterTypes;
+	m_TypeCacheReady.store(true, std::memory_order_release);
 }
 
 string JPMethod::toString() const
@@ -181,6 +196,7 @@ void JPMethod::packArgs(JPJavaFrame &frame, JPMethodMatch &match,
 		vector<jvalue> &v, JPPyObjectVector &arg)
 {
 	JP_TRACE_IN("JPMethod::packArgs");
+	JPStatTimer timer(JPStat_conversionTime);
 	size_t len = arg.size();
 	size_t tlen = m_ParameterTypes.size();
 	JP_TRACE("skip", match.m_Skip == 1);
@@ -203,6 +219,59 @@ void JPMethod::packArgs(JPJavaFrame &frame, JPMethodMatch &match,
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
 
+bool JPMethod::holdGIL() const
+{
+	if (m_GILPolicy != _gilDefault)
+		return m_GILPolicy == _gilHold;
+	return _jp_gil_adaptive && m_GILShort && m_GILSamples >= 0;
+}
+
+void JPMethod::recordGIL(long long elapsed)
+{
+	// A method that is ever slow always releases.  Otherwise it keeps the
+	// GIL once enough short calls have been seen.
+	int samples = m_GILSamples.load(std::memory_order_relaxed);
+	if (samples < 0)
+		return;
+	if (elapsed > _jp_gil_threshold)
+	{
+		m_GILSamples = -1;
+		m_GILShort = false;
+		return;
+	}
+	if (samples >= JP_GIL_SAMPLES)
+		return;
+	// Concurrent samples may be dropped, but a slow verdict is never undone.
+	if (m_GILSamples.compare_exchange_strong(samples, samples + 1)
+			&& samples + 1 >= JP_GIL_SAMPLES)
+		m_GILShort = true;
+}
+
+/**
+ * Keep the GIL for the next Java call if requested and clear the request
+ * on exit in case the call did not consume it.
+ */
+class JPGILHold
+{
+public:
+
+	JPGILHold(bool hold)
+	: m_Hold(hold)
+	{
+		if (m_Hold)
+			JPPyCallRelease::hold(true);
+	}
+
+	~JPGILHold()
+	{
+		if (m_Hold)
+			JPPyCallRelease::hold(false);
+	}
+
+private:
+	bool m_Hold;
+} ;
+
 JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance)
 {
 	JP_TRACE_IN("JPMethod::invoke");
@@ -217,12 +286,19 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 	vector<jvalue> v(alen + 1);
 	packArgs(frame, match, v, arg);
 
+	// Time the call if the GIL policy is adaptive
+	bool adaptive = _jp_gil_adaptive && m_GILPolicy == _gilDefault && m_GILSamples >= 0;
+	long long start = adaptive ? JPStats_clock() : 0;
+	long long wait = adaptive ? JPPyCallRelease::getWaitTime() : 0;
+
 	// Invoke the method (arg[0] = this)
+	JPPyObject out;
 	if (JPModifier::isStatic(m_Modifiers))
 	{
 		JP_TRACE("invoke static", m_Name);
 		jclass claz = m_Class->getJavaClass();
-		return retType->invokeStatic(frame, claz, m_MethodID, &v[0]);
+		JPGILHold hold(holdGIL());
+		out = retType->invokeStatic(frame, claz, m_MethodID, &v[0]);
 	} else
 	{
 		JPValue* selfObj = PyJPValue_getJavaSlot(arg[0]);
@@ -246,8 +322,111 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 		{
 			JP_TRACE("invoke virtual", m_Name);
 		}
-		return retType->invoke(frame, c, clazz, m_MethodID, &v[0]);
+		JPGILHold hold(holdGIL());
+		out = retType->invoke(frame, c, clazz, m_MethodID, &v[0]);
+	}
+	if (adaptive)
+	{
+		// Time waiting for other Python threads is not charged to the method
+		wait = JPPyCallRelease::getWaitTime() - wait;
+		recordGIL(JPStats_clock() - start - wait);
+	}
+	return out;
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
+JPPyObject JPMethod::invokeBound(JPJavaFrame& frame, JPPyObjectVector& arg, bool instance)
+{
+	JP_TRACE_IN("JPMethod::invokeBound");
+	JP_STAT_INC(JPStat_boundCalls);
+	JPMethodMatch match(frame, arg, instance);
+	if (matches(frame, match, instance, arg) < JPMatch::_implicit)
+	{
+		std::stringstream ss;
+		ss << "Arguments do not match bound overload " << m_Class->getCanonicalName()
+				<< "." << m_Name << "(";
+		size_t start = instance ? 1 : 0;
+		for (size_t i = start; i < arg.size(); ++i)
+		{
+			if (i != start)
+				ss << ",";
+			ss << Py_TYPE(arg[i])->tp_name;
+		}
+		ss << ")";
+		JP_RAISE(PyExc_TypeError, ss.str());
+	}
+	return invoke(frame, match, arg, instance);
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
+JPPyObject JPMethod::invokeVectorized(JPJavaFrame& frame, JPPyObjectVector& arg, bool parallel)
+{
+	JP_TRACE_IN("JPMethod::invokeVectorized");
+	ensureTypeCache();
+	JPContext *context = m_Class->getContext();
+	if (!isStatic())
+		JP_RAISE(PyExc_TypeError, "vectorize requires a static method");
+	if (!m_ReturnType->isPrimitive() || m_ReturnType == context->_void)
+		JP_RAISE(PyExc_TypeError, "vectorize requires a primitive return type");
+	size_t alen = m_ParameterTypes.size();
+	if (arg.size() != alen)
+	{
+		std::stringstream ss;
+		ss << "vectorize expected " << alen << " arguments, got " << arg.size();
+		JP_RAISE(PyExc_TypeError, ss.str());
+	}
+
+	// Find the length of the result.  Scalars and length one arguments
+	// are broadcast.
+	vector<Py_ssize_t> lengths(alen);
+	Py_ssize_t n = 1;
+	for (size_t i = 0; i < alen; ++i)
+	{
+		if (!m_ParameterTypes[i]->isPrimitive())
+			JP_RAISE(PyExc_TypeError, "vectorize requires primitive parameter types");
+		lengths[i] = PyObject_Length(arg[i]);
+		if (lengths[i] < 0)
+		{
+			PyErr_Clear();
+			continue;
+		}
+		if (lengths[i] == 1)
+			continue;
+		if (n != 1 && n != lengths[i])
+			JP_RAISE(PyExc_ValueError, "vectorize arguments must have the same length");
+		n = lengths[i];
+	}
+	if (n > 0x7fffffff)
+		JP_RAISE(PyExc_ValueError, "vectorize arguments are too long");
+
+	// Transfer each argument to Java once
+	jobjectArray ja = frame.NewObjectArray((jsize) alen, context->_java_lang_Object->getJavaClass(), NULL);
+	{
+		JPStatTimer timer(JPStat_conversionTime);
+		for (size_t i = 0; i < alen; ++i)
+		{
+			JPClass *type = m_ParameterTypes[i];
+			JPPyObject seq = JPPyObject::use(arg[i]);
+			if (lengths[i] < 0)
+			{
+				seq = JPPyObject::call(PyTuple_Pack(1, arg[i]));
+				lengths[i] = 1;
+			}
+			jarray a = type->newArrayOf(frame, (jsize) lengths[i]);
+			type->setArrayRange(frame, a, 0, (jsize) lengths[i], 1, seq.get());
+			frame.SetObjectArrayElement(ja, (jsize) i, a);
+			frame.DeleteLocalRef(a);
+		}
+	}
+
+	// Run the loop in Java
+	jvalue v;
+	{
+		JPPyCallRelease call;
+		v.l = frame.vectorize(m_Method.get(), ja, (jint) n, parallel);
 	}
+	JPClass *cls = frame.findClassForObject(v.l);
+	return cls->convertToPythonObject(frame, v, false);
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
 
@@ -398,7 +577,7 @@ bool JPMethod::checkMoreSpecificThan(JPMethod* other) const
 
 void JPMethod::ensureTypeCache()
 {
-	if (m_ReturnType != (JPClass*) (-1))
+	if (m_TypeCacheReady.load(std::memory_order_acquire))
 		return;
 
 	m_Class->getContext()->getTypeManager()->populateMethod(this, m_Method.get());
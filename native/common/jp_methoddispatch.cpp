@@ -27,7 +27,11 @@ JPMethodDispatch::JPMethodDispatch(JPClass* clazz,
 	m_Class = clazz;
 	m_Overloads = overloads;
 	m_Modifiers = modifiers;
-	m_LastCache.m_Hash = -1;
+	m_CacheSequence = 0;
+	m_CacheHash = -1;
+	m_CacheOverload = NULL;
+	m_CallCount = 0;
+	m_MissCount = 0;
 }
 
 JPMethodDispatch::~JPMethodDispatch()
@@ -39,6 +43,31 @@ const string& JPMethodDispatch::getName() const
 	return m_Name;
 }
 
+bool JPMethodDispatch::getLastCache(JPMethodCache &cache) const
+{
+	unsigned seq = m_CacheSequence.load(std::memory_order_acquire);
+	if (seq & 1)
+		return false;
+	cache.m_Hash = m_CacheHash.load(std::memory_order_relaxed);
+	cache.m_Overload = m_CacheOverload.load(std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return m_CacheSequence.load(std::memory_order_relaxed) == seq;
+}
+
+void JPMethodDispatch::setLastCache(const JPMethodCache &cache)
+{
+	// Only one writer may hold the lock.  A writer that loses simply skips
+	// the update as the cache is only a hint.
+	unsigned seq = m_CacheSequence.load(std::memory_order_relaxed);
+	if ((seq & 1) || !m_CacheSequence.compare_exchange_strong(seq, seq + 1,
+			std::memory_order_acquire))
+		return;
+	std::atomic_thread_fence(std::memory_order_release);
+	m_CacheHash.store(cache.m_Hash, std::memory_order_relaxed);
+	m_CacheOverload.store(cache.m_Overload, std::memory_order_relaxed);
+	m_CacheSequence.store(seq + 2, std::memory_order_release);
+}
+
 bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch, JPPyObjectVector& arg,
 		bool callInstance, bool raise)
 {
@@ -52,10 +81,11 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 	//   Then make sure we don't hit the rare case that the hash was -1 by chance.
 	//   Then make sure it isn't variadic list match, as the hash of an opaque list
 	//   element can't be resolved without going through the resolution process.
-	if (m_LastCache.m_Hash == bestMatch.m_Hash && m_LastCache.m_Overload != 0
-			&& !m_LastCache.m_Overload->isVarArgs())
+	JPMethodCache last;
+	if (getLastCache(last) && last.m_Hash == bestMatch.m_Hash && last.m_Overload != 0
+			&& !last.m_Overload->isVarArgs())
 	{
-		bestMatch.m_Overload = m_LastCache.m_Overload;
+		bestMatch.m_Overload = last.m_Overload;
 		bestMatch.m_Overload->matches(frame, bestMatch, callInstance, arg);
 
 		// Anything better than explicit constitutes a hit on the cache
@@ -63,6 +93,12 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 			return true;
 	}
 
+	if (_jp_stats_enabled)
+	{
+		m_MissCount++;
+		JPStats_add(JPStat_overloadMisses, 1);
+	}
+
 	// We need two copies of the match.  One to hold the best match we have
 	// found, and one to hold the test of the next overload.
 	JPMethodMatch match = bestMatch;
@@ -81,7 +117,7 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 		{
 			// We can bypass the process here as there is no better match than exact.
 			bestMatch = match;
-			m_LastCache = (JPMethodCache&) match; // lgtm [cpp/slicing]
+			setLastCache(match);
 			return true;
 		}
 		if (match.m_Type < JPMatch::_implicit)
@@ -187,7 +223,7 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 	// Set up a cache to bypass repeated calls.
 	if (bestMatch.m_Type == JPMatch::_implicit)
 	{
-		m_LastCache = (JPMethodCache&) bestMatch; // lgtm [cpp/slicing]
+		setLastCache(bestMatch);
 	}
 
 	JP_TRACE("Best match", bestMatch.m_Overload->toString());
@@ -198,6 +234,11 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 JPPyObject JPMethodDispatch::invoke(JPJavaFrame& frame, JPPyObjectVector& args, bool instance)
 {
 	JP_TRACE_IN("JPMethodDispatch::invoke");
+	if (_jp_stats_enabled)
+	{
+		m_CallCount++;
+		JPStats_add(JPStat_calls, 1);
+	}
 	JPMethodMatch match(frame, args, instance);
 	findOverload(frame, match, args, instance, true);
 	return match.m_Overload->invoke(frame, match, args, instance);
@@ -207,6 +248,11 @@ JPPyObject JPMethodDispatch::invoke(JPJavaFrame& frame, JPPyObjectVector& args,
 JPValue JPMethodDispatch::invokeConstructor(JPJavaFrame& frame, JPPyObjectVector& args)
 {
 	JP_TRACE_IN("JPMethodDispatch::invokeConstructor");
+	if (_jp_stats_enabled)
+	{
+		m_CallCount++;
+		JPStats_add(JPStat_calls, 1);
+	}
 	JPMethodMatch match(frame, args, false);
 	findOverload(frame, match, args, false, true);
 	return match.m_Overload->invokeConstructor(frame, match, args);
@@ -0,0 +1,109 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "jpype.h"
+#include "jp_parallel.h"
+
+namespace
+{
+// Below this a transfer is memory latency bound on a single core
+Py_ssize_t parallel_threshold = 16 * 1024 * 1024;
+int parallel_workers = 0;
+const int parallel_max_workers = 8;
+// Each pinned row holds a local reference
+const Py_ssize_t parallel_max_rows = 1024;
+}
+
+void JPParallel::setPolicy(Py_ssize_t threshold, int workers)
+{
+	parallel_threshold = threshold;
+	parallel_workers = workers;
+}
+
+Py_ssize_t JPParallel::getThreshold()
+{
+	return parallel_threshold;
+}
+
+int JPParallel::getWorkers()
+{
+	return parallel_workers;
+}
+
+int JPParallel::plan(Py_ssize_t bytes)
+{
+	if (bytes < parallel_threshold || parallel_workers == 1)
+		return 1;
+	int workers = parallel_workers;
+	if (workers <= 0)
+	{
+		workers = (int) std::thread::hardware_concurrency();
+		if (workers > parallel_max_workers)
+			workers = parallel_max_workers;
+	}
+	if (workers < 1)
+		return 1;
+	return workers;
+}
+
+Py_ssize_t JPParallel::batch(Py_ssize_t rowBytes, int workers)
+{
+	Py_ssize_t rows = parallel_threshold / (rowBytes > 0 ? rowBytes : 1);
+	if (rows > parallel_max_rows)
+		rows = parallel_max_rows;
+	if (rows < workers)
+		rows = workers;
+	return rows;
+}
+
+void JPParallel::forEach(Py_ssize_t n, int workers,
+		const std::function<void(Py_ssize_t, Py_ssize_t)>& fn)
+{
+	if (workers <= 1 || n < workers)
+	{
+		fn(0, n);
+		return;
+	}
+
+	Py_ssize_t slab = (n + workers - 1) / workers;
+	std::vector<std::thread> threads;
+	threads.reserve(workers - 1);
+	for (int i = 1; i < workers; ++i)
+	{
+		Py_ssize_t first = slab * i;
+		Py_ssize_t last = first + slab;
+		if (first >= n)
+			break;
+		if (last > n)
+			last = n;
+		try
+		{
+			threads.push_back(std::thread(fn, first, last));
+		} catch (std::system_error&)  // GCOVR_EXCL_LINE
+		{
+			// Out of threads so do the work here
+			fn(first, last);  // GCOVR_EXCL_LINE
+		}
+	}
+
+	// The calling thread takes the first slab
+	fn(0, slab < n ? slab : n);
+	for (std::vector<std::thread>::iterator iter = threads.begin();
+			iter != threads.end(); ++iter)
+		iter->join();
+}
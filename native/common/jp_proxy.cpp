@@ -59,6 +59,7 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 
 	// We need the resources to be held for the full duration of the proxy.
 	JPPyCallAcquire callback;
+	JP_STAT_INC(JPStat_proxyCallbacks);
 	{
 		JP_TRACE_IN("JPype_InvocationHandler_hostInvoke");
 		JP_TRACE("context", context);
@@ -227,6 +228,13 @@ jvalue JPProxy::getProxy()
 	JP_TRACE_OUT;
 }
 
+jobject JPProxy::findInstance(JPJavaFrame& frame)
+{
+	if (m_Ref == NULL)
+		return NULL;
+	return frame.NewLocalRef(m_Ref);
+}
+
 JPProxyType::JPProxyType(JPJavaFrame& frame,
 		jclass clss,
 		const string& name,
@@ -294,10 +302,26 @@ JPProxyFunctional::JPProxyFunctional(JPContext* context, PyJPProxy* inst, JPClas
 : JPProxy(context, inst, intf)
 {
 	m_Functional = (JPFunctional*) intf[0];
+	m_Key = NULL;
 }
 
 JPProxyFunctional::~JPProxyFunctional()
 {
+	removeFromCache();
+}
+
+void JPProxyFunctional::addToCache(PyObject *callable)
+{
+	m_Key = callable;
+	m_Functional->addProxy(callable, m_Instance);
+}
+
+void JPProxyFunctional::removeFromCache()
+{
+	// The target may already be cleared, so we use the key we stored
+	if (m_Key != NULL && m_Context->isRunning())
+		m_Functional->removeProxy(m_Key, m_Instance);
+	m_Key = NULL;
 }
 
 JPPyObject JPProxyFunctional::getCallable(const string& cname)
@@ -0,0 +1,128 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "jp_stats.h"
+#include <chrono>
+#include <mutex>
+
+int _jp_stats_enabled = 0;
+
+static const char *jp_stats_names[JPStat_COUNT] = {
+	"calls",
+	"overload_misses",
+	"bound_calls",
+	"conversion_ns",
+	"gil_releases",
+	"gil_release_ns",
+	"gil_wait_ns",
+	"gil_held",
+	"frames",
+	"global_refs",
+	"proxy_callbacks",
+	"proxy_cache_hits",
+	"proxy_cache_misses",
+	"array_pins",
+	"array_pin_copies",
+	"array_copy_bytes",
+};
+
+namespace
+{
+
+/**
+ * Counters for one thread.
+ *
+ * Each block is linked into a global list when the thread first records
+ * a value.  When the thread exits its totals are folded into the retired
+ * counts so that they are not lost.
+ */
+struct JPStatsBlock
+{
+	JPStatsBlock();
+	~JPStatsBlock();
+
+	long long m_Value[JPStat_COUNT];
+	JPStatsBlock *m_Next;
+	JPStatsBlock *m_Prev;
+} ;
+
+std::mutex jp_stats_lock;
+JPStatsBlock *jp_stats_head = NULL;
+long long jp_stats_retired[JPStat_COUNT];
+
+JPStatsBlock::JPStatsBlock()
+{
+	memset(m_Value, 0, sizeof (m_Value));
+	std::lock_guard<std::mutex> guard(jp_stats_lock);
+	m_Prev = NULL;
+	m_Next = jp_stats_head;
+	if (m_Next != NULL)
+		m_Next->m_Prev = this;
+	jp_stats_head = this;
+}
+
+JPStatsBlock::~JPStatsBlock()
+{
+	std::lock_guard<std::mutex> guard(jp_stats_lock);
+	for (int i = 0; i < JPStat_COUNT; ++i)
+		jp_stats_retired[i] += m_Value[i];
+	if (m_Prev != NULL)
+		m_Prev->m_Next = m_Next;
+	else
+		jp_stats_head = m_Next;
+	if (m_Next != NULL)
+		m_Next->m_Prev = m_Prev;
+}
+
+thread_local JPStatsBlock jp_stats_local;
+
+}
+
+long long JPStats_clock()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void JPStats_add(int counter, long long value)
+{
+	jp_stats_local.m_Value[counter] += value;
+}
+
+void JPStats_get(long long *values)
+{
+	std::lock_guard<std::mutex> guard(jp_stats_lock);
+	for (int i = 0; i < JPStat_COUNT; ++i)
+		values[i] = jp_stats_retired[i];
+	for (JPStatsBlock *block = jp_stats_head; block != NULL; block = block->m_Next)
+	{
+		for (int i = 0; i < JPStat_COUNT; ++i)
+			values[i] += block->m_Value[i];
+	}
+}
+
+const char *JPStats_getName(int counter)
+{
+	return jp_stats_names[counter];
+}
+
+void JPStats_reset()
+{
+	std::lock_guard<std::mutex> guard(jp_stats_lock);
+	memset(jp_stats_retired, 0, sizeof (jp_stats_retired));
+	for (JPStatsBlock *block = jp_stats_head; block != NULL; block = block->m_Next)
+		memset(block->m_Value, 0, sizeof (block->m_Value));
+}
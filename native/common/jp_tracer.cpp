@@ -42,9 +42,13 @@ public:
 #else
 #include <mutex>
 #endif
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
 
 static int jpype_traceLevel = 0;
-static JPypeTracer* jpype_tracer_last = NULL;
+static thread_local JPypeTracer* jpype_tracer_last = NULL;
 
 std::mutex trace_lock;
 
@@ -67,7 +71,8 @@ static void jpype_indent(int space)
 //This code is not thread safe, thus tracing a multithreaded code is likely
 // to result in crashes.
 
-JPypeTracer::JPypeTracer(const char* name, void* reference) : m_Name(name)
+JPypeTracer::JPypeTracer(const char* name, void* reference)
+: m_Name(name)
 {
 	m_Error = false;
 	m_Last = jpype_tracer_last;
@@ -77,7 +82,7 @@ JPypeTracer::JPypeTracer(const char* name, void* reference) : m_Name(name)
 
 JPypeTracer::~JPypeTracer()
 {
-	traceOut(m_Name.c_str(), m_Error);
+	traceOut(m_Name, m_Error);
 	jpype_tracer_last = m_Last;
 }
 
@@ -204,4 +209,194 @@ void JPypeTracer::traceLocks(const string& msg, void* ref)
 	JPYPE_TRACING_OUTPUT.flush();
 }
 
+/*****************************************************************************/
+// Event tracing
+
+int _jp_trace_events = 0;
+
+namespace
+{
+
+const size_t JP_TRACE_EVENTS_CAPACITY = 1 << 16;
+
+struct JPTraceEvent
+{
+	long long m_Time;
+	const char *m_Name;
+	char m_Phase;
+	char m_Category;
+} ;
+
+/**
+ * Ring buffer of events for one thread.
+ *
+ * Only the owning thread writes the events and the head.  The head is
+ * published with release ordering so that a reader sees every event before
+ * the head.  Clearing only moves the start mark, so it never races with the
+ * owner.  Buffers of threads that have exited are kept until cleared so
+ * that their events still appear in the dump.
+ */
+struct JPTraceBuffer
+{
+	JPTraceBuffer();
+
+	void record(const char *name, char phase, char category)
+	{
+		size_t head = m_Head.load(std::memory_order_relaxed);
+		JPTraceEvent &event = m_Events[head % JP_TRACE_EVENTS_CAPACITY];
+		event.m_Time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		event.m_Name = name;
+		event.m_Phase = phase;
+		event.m_Category = category;
+		m_Head.store(head + 1, std::memory_order_release);
+	}
+
+	std::vector<JPTraceEvent> m_Events;
+	std::atomic<size_t> m_Head;
+	std::atomic<size_t> m_Start;
+	int m_Thread;
+	bool m_Alive;
+} ;
+
+std::mutex trace_buffers_lock;
+std::list<JPTraceBuffer*> trace_buffers;
+int trace_thread_count = 0;
+
+JPTraceBuffer::JPTraceBuffer()
+: m_Events(JP_TRACE_EVENTS_CAPACITY), m_Head(0), m_Start(0), m_Alive(true)
+{
+	std::lock_guard<std::mutex> guard(trace_buffers_lock);
+	m_Thread = ++trace_thread_count;
+	trace_buffers.push_back(this);
+}
+
+/**
+ * Owner of the buffer for the current thread.
+ *
+ * The buffer is created on the first event so threads that never record
+ * cost nothing.
+ */
+struct JPTraceLocal
+{
+	JPTraceBuffer *m_Buffer;
+	bool m_Exited;
+
+	JPTraceLocal() : m_Buffer(NULL), m_Exited(false)
+	{
+	}
+
+	~JPTraceLocal()
+	{
+		// Events from later thread local destructors are dropped, as the
+		// buffer now belongs to the list and may be freed by clear.
+		m_Exited = true;
+		if (m_Buffer == NULL)
+			return;
+		std::lock_guard<std::mutex> guard(trace_buffers_lock);
+		m_Buffer->m_Alive = false;
+		m_Buffer = NULL;
+	}
+
+	JPTraceBuffer *get()
+	{
+		if (m_Buffer == NULL && !m_Exited)
+			m_Buffer = new JPTraceBuffer();
+		return m_Buffer;
+	}
+} ;
+
+thread_local JPTraceLocal trace_local;
+
+void jpype_json_string(std::ostream& out, const char *str)
+{
+	out << '"';
+	for (const char *c = str; *c != 0; ++c)
+	{
+		if (*c == '"' || *c == '\\')
+			out << '\\';
+		out << *c;
+	}
+	out << '"';
+}
+
+}
+
+void JPTraceEvents::begin(const char *name, char category)
+{
+	JPTraceBuffer *buffer = trace_local.get();
+	if (buffer != NULL)
+		buffer->record(name, 'B', category);
+}
+
+void JPTraceEvents::end(const char *name, char category)
+{
+	JPTraceBuffer *buffer = trace_local.get();
+	if (buffer != NULL)
+		buffer->record(name, 'E', category);
+}
+
+bool JPTraceEvents::dump(const char *filename)
+{
+	std::ofstream out(filename);
+	if (!out)
+		return false;
+	static const char *categories[] = {"jpype", "transition"};
+	std::lock_guard<std::mutex> guard(trace_buffers_lock);
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	for (std::list<JPTraceBuffer*>::iterator iter = trace_buffers.begin();
+			iter != trace_buffers.end(); ++iter)
+	{
+		JPTraceBuffer *buffer = *iter;
+		if (!first)
+			out << ",";
+		first = false;
+		out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+				<< buffer->m_Thread << ",\"args\":{\"name\":\"thread " << buffer->m_Thread
+				<< (buffer->m_Alive ? "" : " (exited)") << "\"}}";
+
+		size_t head = buffer->m_Head.load(std::memory_order_acquire);
+		size_t start = head > JP_TRACE_EVENTS_CAPACITY ? head - JP_TRACE_EVENTS_CAPACITY : 0;
+		size_t cleared = buffer->m_Start.load(std::memory_order_acquire);
+		if (start < cleared)
+			start = cleared;
+		for (size_t i = start; i < head; ++i)
+		{
+			JPTraceEvent &event = buffer->m_Events[i % JP_TRACE_EVENTS_CAPACITY];
+			out << ",\n{\"name\":";
+			jpype_json_string(out, event.m_Name);
+			out << ",\"cat\":\"" << categories[(int) event.m_Category]
+					<< "\",\"ph\":\"" << event.m_Phase
+					<< "\",\"ts\":" << event.m_Time / 1000 << "." ;
+			// Chrome expects microseconds, keep the nanoseconds as the fraction
+			long long ns = event.m_Time % 1000;
+			out << (char) ('0' + ns / 100) << (char) ('0' + (ns / 10) % 10) << (char) ('0' + ns % 10);
+			out << ",\"pid\":1,\"tid\":" << buffer->m_Thread << "}";
+		}
+	}
+	out << "\n]}\n";
+	return out.good();
+}
+
+void JPTraceEvents::clear()
+{
+	std::lock_guard<std::mutex> guard(trace_buffers_lock);
+	for (std::list<JPTraceBuffer*>::iterator iter = trace_buffers.begin();
+			iter != trace_buffers.end(); )
+	{
+		JPTraceBuffer *buffer = *iter;
+		if (!buffer->m_Alive)
+		{
+			delete buffer;
+			iter = trace_buffers.erase(iter);
+			continue;
+		}
+		// The owner keeps writing, so only the start of the dump is moved
+		buffer->m_Start.store(buffer->m_Head.load(std::memory_order_acquire),
+				std::memory_order_release);
+		++iter;
+	}
+}
+
 // GCOVR_EXCL_STOP
\ No newline at end of file
@@ -149,7 +149,7 @@ jdouble JPVoidType::getAsDouble(jvalue v)
 }
 
 PyObject *JPVoidType::newMultiArray(JPJavaFrame &frame,
-		JPPyBuffer& view, int subs, int base, jobject dims)
+		JPPyBuffer& view, int subs, int base)
 {
 	return NULL;
 }
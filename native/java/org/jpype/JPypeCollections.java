@@ -0,0 +1,320 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+  
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Bulk conversion of nested collections.
+ *
+ * A tree of maps, lists and scalars is passed across JNI in a flat
+ * preorder encoding so that it can be built or visited with a single call.
+ * Each node has a code.  Scalars store their value in the long, double or
+ * object stream.  Maps and lists store their size in the long stream and
+ * are followed by their children, with keys and values interleaved for
+ * maps.
+ */
+public class JPypeCollections
+{
+
+  public static final byte NULL = 0;
+  public static final byte STRING = 1;
+  public static final byte BOOLEAN = 2;
+  public static final byte LONG = 3;
+  public static final byte DOUBLE = 4;
+  public static final byte MAP = 5;
+  public static final byte LIST = 6;
+  public static final byte OBJECT = 7;
+
+  static final int MAX_DEPTH = 1000;
+
+  /**
+   * Build a tree of HashMap and ArrayList from the flat encoding.
+   *
+   * @param codes is the node codes in preorder.
+   * @param longs is the booleans, integers and container sizes.
+   * @param doubles is the floating point values.
+   * @param objects is the strings and other objects.
+   * @return the root of the tree.
+   */
+  public static Object build(byte[] codes, long[] longs, double[] doubles, Object[] objects)
+  {
+    return new Builder(codes, longs, doubles, objects).next();
+  }
+
+  /**
+   * Encode a tree of maps and collections.
+   *
+   * Boxed integer types are widened to long and floating point types to
+   * double.  Characters are encoded as strings.  Other objects, including
+   * arrays, are passed as objects.
+   *
+   * @param root is the object to encode.
+   * @return an array holding the code, long, double, and object streams.
+   * @throws IllegalArgumentException if the tree is nested too deeply,
+   * which usually means that it contains itself.
+   */
+  public static Object[] flatten(Object root)
+  {
+    Flattener f = new Flattener();
+    f.visit(root, 0);
+    return new Object[]
+    {
+      Arrays.copyOf(f.codes, f.ncodes),
+      Arrays.copyOf(f.longs, f.nlongs),
+      Arrays.copyOf(f.doubles, f.ndoubles),
+      f.objects.toArray()
+    };
+  }
+
+  /**
+   * Unbox a collection or array of numbers into a primitive array.
+   *
+   * When no type is given, integral boxes give a long array and any other
+   * number gives a double array.  Null elements are stored as zero and
+   * flagged in the mask.
+   *
+   * @param src is a Collection of Number or an array of Number.
+   * @param type is 'J' for long, 'D' for double, or 0 to choose.
+   * @param mask is true to return a mask of null elements rather than fail.
+   * @return an array holding the values and the mask, which is null if not
+   * requested.
+   * @throws IllegalArgumentException if an element is not a number, or is
+   * null without a mask.
+   */
+  public static Object[] unbox(Object src, char type, boolean mask)
+  {
+    Object[] items;
+    if (src instanceof Collection)
+      items = ((Collection<?>) src).toArray();
+    else if (src instanceof Object[])
+      items = (Object[]) src;
+    else
+      throw new IllegalArgumentException("Collection or array of numbers is required");
+
+    int n = items.length;
+    boolean[] nulls = mask ? new boolean[n] : null;
+    if (type == 0)
+    {
+      type = 'J';
+      for (Object o : items)
+      {
+        if (o != null && !(o instanceof Long || o instanceof Integer
+                || o instanceof Short || o instanceof Byte))
+        {
+          type = 'D';
+          break;
+        }
+      }
+    }
+
+    if (type == 'J')
+    {
+      long[] values = new long[n];
+      for (int i = 0; i < n; ++i)
+      {
+        Number v = number(items, i, nulls);
+        if (v != null)
+          values[i] = v.longValue();
+      }
+      return new Object[]
+      {
+        values, nulls
+      };
+    }
+    double[] values = new double[n];
+    for (int i = 0; i < n; ++i)
+    {
+      Number v = number(items, i, nulls);
+      if (v != null)
+        values[i] = v.doubleValue();
+    }
+    return new Object[]
+    {
+      values, nulls
+    };
+  }
+
+  private static Number number(Object[] items, int i, boolean[] nulls)
+  {
+    Object o = items[i];
+    if (o instanceof Number)
+      return (Number) o;
+    if (o != null)
+      throw new IllegalArgumentException("Element " + i + " is not a number");
+    if (nulls == null)
+      throw new IllegalArgumentException("Element " + i + " is null");
+    nulls[i] = true;
+    return null;
+  }
+
+  static class Builder
+  {
+
+    byte[] codes;
+    long[] longs;
+    double[] doubles;
+    Object[] objects;
+    int ncodes, nlongs, ndoubles, nobjects;
+
+    Builder(byte[] codes, long[] longs, double[] doubles, Object[] objects)
+    {
+      this.codes = codes;
+      this.longs = longs;
+      this.doubles = doubles;
+      this.objects = objects;
+    }
+
+    Object next()
+    {
+      switch (codes[ncodes++])
+      {
+        case NULL:
+          return null;
+        case STRING:
+        case OBJECT:
+          return objects[nobjects++];
+        case BOOLEAN:
+          return longs[nlongs++] != 0;
+        case LONG:
+          return longs[nlongs++];
+        case DOUBLE:
+          return doubles[ndoubles++];
+        case MAP:
+        {
+          int n = (int) longs[nlongs++];
+          HashMap<Object, Object> map = new HashMap<>(Math.max(n * 4 / 3 + 1, 16));
+          for (int i = 0; i < n; ++i)
+          {
+            Object key = next();
+            map.put(key, next());
+          }
+          return map;
+        }
+        case LIST:
+        {
+          int n = (int) longs[nlongs++];
+          ArrayList<Object> list = new ArrayList<>(n);
+          for (int i = 0; i < n; ++i)
+          {
+            list.add(next());
+          }
+          return list;
+        }
+        default:
+          throw new IllegalArgumentException("Bad collection code " + codes[ncodes - 1]);
+      }
+    }
+  }
+
+  static class Flattener
+  {
+
+    byte[] codes = new byte[64];
+    long[] longs = new long[64];
+    double[] doubles = new double[16];
+    List<Object> objects = new ArrayList<>();
+    int ncodes, nlongs, ndoubles;
+
+    void code(byte c)
+    {
+      if (ncodes == codes.length)
+        codes = Arrays.copyOf(codes, ncodes * 2);
+      codes[ncodes++] = c;
+    }
+
+    void addLong(long l)
+    {
+      if (nlongs == longs.length)
+        longs = Arrays.copyOf(longs, nlongs * 2);
+      longs[nlongs++] = l;
+    }
+
+    void addDouble(double d)
+    {
+      if (ndoubles == doubles.length)
+        doubles = Arrays.copyOf(doubles, ndoubles * 2);
+      doubles[ndoubles++] = d;
+    }
+
+    void visit(Object o, int depth)
+    {
+      if (depth > MAX_DEPTH)
+        throw new IllegalArgumentException("Collection is nested too deeply");
+      if (o == null)
+      {
+        code(NULL);
+      } else if (o instanceof String)
+      {
+        code(STRING);
+        objects.add(o);
+      } else if (o instanceof Boolean)
+      {
+        code(BOOLEAN);
+        addLong(((Boolean) o) ? 1 : 0);
+      } else if (o instanceof Long || o instanceof Integer
+              || o instanceof Short || o instanceof Byte)
+      {
+        code(LONG);
+        addLong(((Number) o).longValue());
+      } else if (o instanceof Double || o instanceof Float)
+      {
+        code(DOUBLE);
+        addDouble(((Number) o).doubleValue());
+      } else if (o instanceof Character)
+      {
+        code(STRING);
+        objects.add(o.toString());
+      } else if (o instanceof Map)
+      {
+        // Sizes are counted while visiting as concurrent collections
+        // may not agree with their own size.
+        code(MAP);
+        int slot = nlongs;
+        addLong(0);
+        int n = 0;
+        for (Map.Entry<?, ?> e : ((Map<?, ?>) o).entrySet())
+        {
+          visit(e.getKey(), depth + 1);
+          visit(e.getValue(), depth + 1);
+          n++;
+        }
+        longs[slot] = n;
+      } else if (o instanceof Collection)
+      {
+        code(LIST);
+        int slot = nlongs;
+        addLong(0);
+        int n = 0;
+        for (Object e : (Collection<?>) o)
+        {
+          visit(e, depth + 1);
+          n++;
+        }
+        longs[slot] = n;
+      } else
+      {
+        code(OBJECT);
+        objects.add(o);
+      }
+    }
+  }
+}
@@ -348,6 +348,23 @@ public class JPypeContext
     }
   }
 
+  /**
+   * Apply a static method elementwise over primitive arrays.
+   *
+   * @param method is the static method to call.
+   * @param args holds a primitive array for each parameter.
+   * @param n is the number of results.
+   * @param parallel runs the loop in the fork join pool if true.
+   * @return a primitive array with the results.
+   * @throws java.lang.Throwable throws whatever type the called method
+   * produces.
+   */
+  public Object vectorize(Method method, Object[] args, int n, boolean parallel)
+          throws Throwable
+  {
+    return JPypeVectorize.apply(method, args, n, parallel);
+  }
+
   /**
    * Helper function for collect rectangular,
    */
@@ -386,76 +403,40 @@ public class JPypeContext
   {
     if (o == null || !o.getClass().isArray())
       return null;
-    int[] shape = new int[5];
-    int d = 0;
-    ArrayList<Object> out = new ArrayList<>();
+    ArrayList<Integer> dims = new ArrayList<>();
     Object o1 = o;
     Class c1 = o1.getClass();
-    for (int i = 0; i < 5; ++i)
+    while (true)
     {
       int l = Array.getLength(o1);
       if (l == 0)
         return null;
-      shape[d++] = l;
-      o1 = Array.get(o1, 0);
-      if (o1 == null)
-        return null;
+      dims.add(l);
       c1 = c1.getComponentType();
       if (!c1.isArray())
         break;
+      o1 = Array.get(o1, 0);
+      if (o1 == null)
+        return null;
     }
     if (!c1.isPrimitive())
       return null;
+    int d = dims.size();
+    int[] shape = new int[d];
+    for (int i = 0; i < d; ++i)
+      shape[i] = dims.get(i);
+    ArrayList<Object> out = new ArrayList<>();
     out.add(c1);
-    shape = Arrays.copyOfRange(shape, 0, d);
     out.add(shape);
     int total = 1;
     for (int i = 0; i < d - 1; i++)
       total *= shape[i];
     out.ensureCapacity(total + 2);
-    if (d == 5)
-      return null;
     if (!collect(out, o, 0, shape, d))
       return null;
     return out.toArray();
   }
 
-  private Object unpack(int size, Object parts)
-  {
-    Object e0 = Array.get(parts, 0);
-    Class c = e0.getClass();
-    int segments = Array.getLength(parts) / size;
-    Object a2 = Array.newInstance(c, size);
-    Object a1 = Array.newInstance(a2.getClass(), segments);
-    int k = 0;
-    for (int i = 0; i < segments; i++)
-    {
-      for (int j = 0; j < size; j++, k++)
-      {
-        Object o = Array.get(parts, k);
-        Array.set(a2, j, o);
-      }
-      Array.set(a1, i, a2);
-      if (i < segments - 1)
-        a2 = Array.newInstance(c, size);
-    }
-    return a1;
-  }
-
-  public Object assemble(int[] dims, Object parts)
-  {
-    int n = dims.length;
-    if (n == 1)
-      return Array.get(parts, 0);
-    if (n == 2)
-      return Array.get(unpack(dims[0], parts), 0);
-    for (int i = 0; i < n - 2; ++i)
-    {
-      parts = unpack(dims[n - i - 2], parts);
-    }
-    return parts;
-  }
-
   public boolean isShutdown()
   {
     return shutdownFlag.get() > 0;
@@ -0,0 +1,173 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+  
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype;
+
+import java.math.BigDecimal;
+import java.math.BigInteger;
+import java.time.Instant;
+import java.time.LocalDate;
+import java.time.LocalDateTime;
+import java.time.LocalTime;
+import java.time.OffsetDateTime;
+import java.time.ZoneOffset;
+import java.time.ZonedDateTime;
+import java.util.ArrayList;
+
+/**
+ * Bulk extraction of date, time and decimal values.
+ *
+ * Each value is reduced to a kind code and two longs so that Python can
+ * construct the matching datetime or Decimal without calling the
+ * individual field getters.
+ *
+ * <ul>
+ * <li>DATE: days since 1970-01-01.</li>
+ * <li>TIME: microseconds since midnight.</li>
+ * <li>DATETIME: microseconds since 1970-01-01T00:00 in local time.</li>
+ * <li>INSTANT: microseconds since the epoch in UTC.</li>
+ * <li>OFFSET: local microseconds and the offset in seconds.</li>
+ * <li>ZONED: local microseconds, with the zone id string index in the high
+ * word and the offset in seconds in the low word.</li>
+ * <li>DECIMAL: unscaled value and scale.</li>
+ * <li>DECIMAL_STRING: scale with the unscaled value as a string.</li>
+ * </ul>
+ *
+ * The deprecated java.sql getters work in the default time zone so the
+ * java.sql types are converted to their local java.time equivalents.
+ */
+public class JPypeDataTypes
+{
+
+  public static final byte NULL = 0;
+  public static final byte DATE = 1;
+  public static final byte TIME = 2;
+  public static final byte DATETIME = 3;
+  public static final byte INSTANT = 4;
+  public static final byte OFFSET = 5;
+  public static final byte DECIMAL = 6;
+  public static final byte DECIMAL_STRING = 7;
+  public static final byte OTHER = 8;
+  public static final byte ZONED = 9;
+
+  /**
+   * Encode a column of values.
+   *
+   * @param values is the values to encode.
+   * @return an array holding the kinds, two longs per value, and the
+   * strings for decimals that do not fit in a long.
+   */
+  public static Object[] encode(Object[] values)
+  {
+    int n = values.length;
+    byte[] kinds = new byte[n];
+    long[] data = new long[2 * n];
+    ArrayList<String> strings = new ArrayList<>();
+    for (int i = 0; i < n; ++i)
+    {
+      kinds[i] = encode(values[i], data, 2 * i, strings);
+    }
+    return new Object[]
+    {
+      kinds, data, strings.toArray()
+    };
+  }
+
+  static long micros(long seconds, int nanos)
+  {
+    return Math.addExact(Math.multiplyExact(seconds, 1000000L), nanos / 1000);
+  }
+
+  static long micros(LocalDateTime ldt)
+  {
+    return micros(ldt.toEpochSecond(ZoneOffset.UTC), ldt.getNano());
+  }
+
+  static byte encode(Object o, long[] data, int i, ArrayList<String> strings)
+  {
+    if (o == null)
+      return NULL;
+    if (o instanceof java.sql.Timestamp)
+    {
+      data[i] = micros(((java.sql.Timestamp) o).toLocalDateTime());
+      return DATETIME;
+    }
+    if (o instanceof java.sql.Date)
+    {
+      data[i] = ((java.sql.Date) o).toLocalDate().toEpochDay();
+      return DATE;
+    }
+    if (o instanceof java.sql.Time)
+    {
+      data[i] = ((java.sql.Time) o).toLocalTime().toSecondOfDay() * 1000000L;
+      return TIME;
+    }
+    if (o instanceof BigDecimal)
+    {
+      BigDecimal d = (BigDecimal) o;
+      BigInteger unscaled = d.unscaledValue();
+      data[i + 1] = d.scale();
+      if (unscaled.bitLength() < 64)
+      {
+        data[i] = unscaled.longValue();
+        return DECIMAL;
+      }
+      data[i] = strings.size();
+      strings.add(unscaled.toString());
+      return DECIMAL_STRING;
+    }
+    if (o instanceof LocalDateTime)
+    {
+      data[i] = micros((LocalDateTime) o);
+      return DATETIME;
+    }
+    if (o instanceof LocalDate)
+    {
+      data[i] = ((LocalDate) o).toEpochDay();
+      return DATE;
+    }
+    if (o instanceof LocalTime)
+    {
+      data[i] = ((LocalTime) o).toNanoOfDay() / 1000;
+      return TIME;
+    }
+    if (o instanceof Instant)
+    {
+      Instant instant = (Instant) o;
+      data[i] = micros(instant.getEpochSecond(), instant.getNano());
+      return INSTANT;
+    }
+    if (o instanceof OffsetDateTime)
+    {
+      OffsetDateTime odt = (OffsetDateTime) o;
+      data[i] = micros(odt.toLocalDateTime());
+      data[i + 1] = odt.getOffset().getTotalSeconds();
+      return OFFSET;
+    }
+    if (o instanceof ZonedDateTime)
+    {
+      ZonedDateTime zdt = (ZonedDateTime) o;
+      data[i] = micros(zdt.toLocalDateTime());
+      data[i + 1] = zdt.getOffset().getTotalSeconds();
+      if (zdt.getZone() instanceof ZoneOffset)
+        return OFFSET;
+      // The offset is kept so Python can fall back if the zone is unknown
+      data[i + 1] = ((long) strings.size() << 32) | (data[i + 1] & 0xffffffffL);
+      strings.add(zdt.getZone().getId());
+      return ZONED;
+    }
+    return OTHER;
+  }
+}
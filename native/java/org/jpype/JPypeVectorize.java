@@ -0,0 +1,314 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Array;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.stream.IntStream;
+
+/**
+ * Applies a static method elementwise over primitive arrays.
+ *
+ * This backs the vectorize method of a bound overload so that a batch of
+ * calls takes a single trip through JNI. Common signatures such as
+ * {@code double f(double)} and {@code int g(int,int)} are called through
+ * exactly typed method handles so that no boxing takes place. Other
+ * primitive signatures fall back to a boxed call for each element.
+ */
+public class JPypeVectorize
+{
+
+  // Number of elements given to each task when running in parallel.
+  static final int BLOCK = 4096;
+
+  // Handles are cached per declaring class.  A cached handle refers to its
+  // class, so a class that has been vectorized stays reachable.
+  private static final ClassValue<Map<Method, MethodHandle>> HANDLES
+          = new ClassValue<Map<Method, MethodHandle>>()
+  {
+    @Override
+    protected Map<Method, MethodHandle> computeValue(Class<?> cls)
+    {
+      return new ConcurrentHashMap<>();
+    }
+  };
+
+  /**
+   * Loop over a range of the output.
+   */
+  interface Kernel
+  {
+
+    void run(int start, int end) throws Throwable;
+  }
+
+  /**
+   * Apply a static method to each element of the arguments.
+   *
+   * Arguments of length one are broadcast to the length of the output.
+   *
+   * @param method is a static method with a primitive signature.
+   * @param args is a primitive array for each parameter.
+   * @param n is the number of elements to produce.
+   * @param parallel runs blocks of the output in the common fork join pool.
+   * @return a primitive array holding the results.
+   * @throws Throwable whatever the method throws.
+   */
+  public static Object apply(Method method, Object[] args, int n, boolean parallel)
+          throws Throwable
+  {
+    Map<Method, MethodHandle> handles = HANDLES.get(method.getDeclaringClass());
+    MethodHandle mh = handles.get(method);
+    if (mh == null)
+    {
+      mh = getHandle(method);
+      handles.put(method, mh);
+    }
+    Class<?>[] params = method.getParameterTypes();
+    for (int i = 0; i < args.length; ++i)
+    {
+      if (n > 1 && Array.getLength(args[i]) == 1)
+        args[i] = broadcast(args[i], params[i], n);
+    }
+    Object out = Array.newInstance(method.getReturnType(), n);
+    Kernel kernel = getKernel(mh, args, out);
+
+    if (!parallel || n <= BLOCK)
+    {
+      kernel.run(0, n);
+      return out;
+    }
+
+    try
+    {
+      // Computed in long as n may be close to the largest int
+      int blocks = (int) (((long) n + BLOCK - 1) / BLOCK);
+      IntStream.range(0, blocks).parallel().forEach(b ->
+      {
+        try
+        {
+          long start = (long) b * BLOCK;
+          kernel.run((int) start, (int) Math.min(n, start + BLOCK));
+        } catch (RuntimeException | Error ex)
+        {
+          throw ex;
+        } catch (Throwable ex)
+        {
+          throw new Wrapped(ex);
+        }
+      });
+    } catch (Wrapped ex)
+    {
+      throw ex.getCause();
+    }
+    return out;
+  }
+
+//<editor-fold desc="kernels" defaultstate="collapsed">
+  /**
+   * Get a handle for a method.
+   *
+   * Public methods of classes that are not public are reached through
+   * setAccessible, as JNI can call them.  If that is refused the method is
+   * called reflectively.
+   */
+  private static MethodHandle getHandle(Method method) throws Throwable
+  {
+    MethodHandles.Lookup lookup = MethodHandles.lookup();
+    try
+    {
+      return lookup.unreflect(method);
+    } catch (IllegalAccessException ex)
+    {
+      // Fall through
+    }
+    try
+    {
+      method.setAccessible(true);
+      return lookup.unreflect(method);
+    } catch (IllegalAccessException | RuntimeException ex)
+    {
+      // Fall through
+    }
+    MethodHandle invoke = lookup.findVirtual(Method.class, "invoke",
+            MethodType.methodType(Object.class, Object.class, Object[].class))
+            .bindTo(method)
+            .bindTo(null);
+    MethodHandle unwrap = lookup.findStatic(JPypeVectorize.class, "unwrap",
+            MethodType.methodType(Object.class, InvocationTargetException.class));
+    invoke = MethodHandles.catchException(invoke, InvocationTargetException.class,
+            MethodHandles.dropArguments(unwrap, 1, Object[].class));
+    return invoke.asCollector(Object[].class, method.getParameterCount())
+            .asType(MethodType.methodType(method.getReturnType(), method.getParameterTypes()));
+  }
+
+  private static Object unwrap(InvocationTargetException ex) throws Throwable
+  {
+    throw ex.getCause();
+  }
+
+  private static Kernel getKernel(MethodHandle mh, Object[] args, Object out)
+  {
+    MethodType type = mh.type();
+    Class<?> ret = type.returnType();
+    boolean uniform = true;
+    for (Class<?> p : type.parameterList())
+    {
+      uniform &= (p == ret);
+    }
+
+    if (uniform && type.parameterCount() == 1)
+    {
+      if (ret == double.class)
+      {
+        double[] x = (double[]) args[0];
+        double[] r = (double[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (double) mh.invokeExact(x[i]);
+        };
+      }
+      if (ret == float.class)
+      {
+        float[] x = (float[]) args[0];
+        float[] r = (float[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (float) mh.invokeExact(x[i]);
+        };
+      }
+      if (ret == int.class)
+      {
+        int[] x = (int[]) args[0];
+        int[] r = (int[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (int) mh.invokeExact(x[i]);
+        };
+      }
+      if (ret == long.class)
+      {
+        long[] x = (long[]) args[0];
+        long[] r = (long[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (long) mh.invokeExact(x[i]);
+        };
+      }
+    }
+
+    if (uniform && type.parameterCount() == 2)
+    {
+      if (ret == double.class)
+      {
+        double[] x = (double[]) args[0];
+        double[] y = (double[]) args[1];
+        double[] r = (double[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (double) mh.invokeExact(x[i], y[i]);
+        };
+      }
+      if (ret == float.class)
+      {
+        float[] x = (float[]) args[0];
+        float[] y = (float[]) args[1];
+        float[] r = (float[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (float) mh.invokeExact(x[i], y[i]);
+        };
+      }
+      if (ret == int.class)
+      {
+        int[] x = (int[]) args[0];
+        int[] y = (int[]) args[1];
+        int[] r = (int[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (int) mh.invokeExact(x[i], y[i]);
+        };
+      }
+      if (ret == long.class)
+      {
+        long[] x = (long[]) args[0];
+        long[] y = (long[]) args[1];
+        long[] r = (long[]) out;
+        return (s, e) ->
+        {
+          for (int i = s; i < e; ++i)
+            r[i] = (long) mh.invokeExact(x[i], y[i]);
+        };
+      }
+    }
+
+    // Anything else is boxed one element at a time
+    MethodHandle spread = mh.asSpreader(Object[].class, args.length)
+            .asType(MethodType.methodType(Object.class, Object[].class));
+    return (s, e) ->
+    {
+      Object[] a = new Object[args.length];
+      for (int i = s; i < e; ++i)
+      {
+        for (int j = 0; j < args.length; ++j)
+        {
+          a[j] = Array.get(args[j], i);
+        }
+        Array.set(out, i, (Object) spread.invokeExact(a));
+      }
+    };
+  }
+
+  /**
+   * Expand an array of length one to length n.
+   */
+  private static Object broadcast(Object a, Class<?> cls, int n)
+  {
+    Object out = Array.newInstance(cls, n);
+    System.arraycopy(a, 0, out, 0, 1);
+    for (int len = 1; len < n; len *= 2)
+    {
+      System.arraycopy(out, 0, out, len, Math.min(len, n - len));
+    }
+    return out;
+  }
+
+  /**
+   * Carries a checked exception out of a parallel stream.
+   */
+  private static class Wrapped extends RuntimeException
+  {
+
+    Wrapped(Throwable cause)
+    {
+      super(cause);
+    }
+  }
+//</editor-fold>
+}
@@ -17,6 +17,7 @@ import java.nio.file.PathMatcher;
 import java.nio.file.SimpleFileVisitor;
 import java.nio.file.attribute.BasicFileAttributes;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.Enumeration;
 import java.util.HashMap;
@@ -42,6 +43,21 @@ public class DynamicClassLoader extends ClassLoader
     return loaders.hashCode();
   }
 
+  /**
+   * Get the locations added to this class loader.
+   *
+   * @return the urls of all jars and directories in the order added.
+   */
+  public List<URL> getURLs()
+  {
+    ArrayList<URL> out = new ArrayList<>();
+    for (URLClassLoader cl : this.loaders)
+    {
+      out.addAll(Arrays.asList(cl.getURLs()));
+    }
+    return out;
+  }
+
   /**
    * Add a set of jars to the classpath.
    *
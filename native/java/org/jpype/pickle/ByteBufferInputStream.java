@@ -15,97 +15,96 @@
 **************************************************************************** */
 package org.jpype.pickle;
 
-import java.io.IOException;
 import java.io.InputStream;
+import java.nio.Buffer;
 import java.nio.ByteBuffer;
 
 /**
+ * InputStream which reads from a sequence of ByteBuffers.
+ *
+ * Buffers are read in place.  Only bytes left over when a new buffer arrives
+ * are copied.
  *
  * @author Karl Einar Nelson
  */
 public class ByteBufferInputStream extends InputStream
 {
 
-  ByteBuffer bb = ByteBuffer.allocate(1024);
-  int loaded = 0;
+  ByteBuffer bb = ByteBuffer.allocate(0);
+  boolean owned = true;
 
   public void put(byte[] bytes)
   {
-    // If we have additional capacity, use it
-    if (bytes.length < bb.remaining())
-    {
-      int p = bb.position();
-      bb.position(loaded);
-      bb.put(bytes);
-      loaded = bb.position();
-      bb.position(p);
-      return;
-    }
-
-    // Okay we may need to allocate more
-    ByteBuffer bb2 = bb;
-    int r = loaded - bb.position();
-
-    // If we don't have space, make a new buffer.
-    if (r + bytes.length > bb.capacity())
-      bb = ByteBuffer.allocate(r + bytes.length);
+    put(ByteBuffer.wrap(bytes));
+    owned = true;
+  }
 
-    // If we have remaining bytes, then keep them
-    if (r > 0)
+  /**
+   * Add a buffer to be read.
+   *
+   * The buffer is used in place until {@link #release()} is called.
+   *
+   * @param data is the buffer to read.
+   */
+  public void put(ByteBuffer data)
+  {
+    data = data.duplicate();
+    if (!bb.hasRemaining())
     {
-      bb.put(bb2.array(), bb2.position(), r);
+      bb = data;
+      owned = false;
+      return;
     }
 
-    // Add the new data
-    bb.put(bytes);
-    loaded = bb.position();
-    bb.position(0);
+    // Join the leftover bytes with the new data
+    ByteBuffer bb2 = ByteBuffer.allocate(bb.remaining() + data.remaining());
+    bb2.put(bb);
+    bb2.put(data);
+    ((Buffer) bb2).flip();
+    bb = bb2;
+    owned = true;
   }
 
-  public int available()
+  /**
+   * Stop referencing the memory of the last buffer added.
+   *
+   * Any unread bytes are copied so the caller may free the buffer.
+   */
+  public void release()
   {
-    int out = loaded - bb.position();
-    return out;
+    if (owned)
+      return;
+    ByteBuffer bb2 = ByteBuffer.allocate(bb.remaining());
+    bb2.put(bb);
+    ((Buffer) bb2).flip();
+    bb = bb2;
+    owned = true;
   }
 
   @Override
-  public int read() throws IOException
+  public int available()
   {
-    int r = loaded - bb.position();
-    if (r > 0)
-    {
-      int p = bb.get();
-      return p;
-    }
-    return -1;
+    return bb.remaining();
   }
 
   @Override
-  public int read(byte[] arg0) throws IOException
+  public int read()
   {
-    int r = loaded - bb.position();
-    if (arg0.length <= r)
-    {
-      bb.get(arg0);
-      return arg0.length;
-    }
-
-    bb.get(arg0, 0, r);
-    return r;
+    if (bb.hasRemaining())
+      return bb.get() & 0xff;
+    return -1;
   }
 
   @Override
-  public int read(byte[] buffer, int offset, int len) throws IOException
+  public int read(byte[] buffer, int offset, int len)
   {
-    int r = loaded - bb.position();
+    int r = bb.remaining();
+    if (len == 0)
+      return 0;
     if (r == 0)
       return -1;
-
     if (len > r)
-    {
       len = r;
-    }
-
     bb.get(buffer, offset, len);
     return len;
   }
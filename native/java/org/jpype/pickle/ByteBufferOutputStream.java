@@ -0,0 +1,94 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.pickle;
+
+import java.io.OutputStream;
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+
+/**
+ * OutputStream which collects into a direct ByteBuffer.
+ *
+ * The contents can be viewed from Python without a copy.
+ */
+public class ByteBufferOutputStream extends OutputStream
+{
+
+  static final int INITIAL = 1024;
+  ByteBuffer bb = ByteBuffer.allocateDirect(INITIAL);
+
+  private void reserve(int len)
+  {
+    if (len <= bb.remaining())
+      return;
+    int required = bb.position() + len;
+    int capacity = Math.max(bb.capacity() * 2, required);
+    if (capacity < 0)
+      capacity = required;
+    ByteBuffer bb2 = ByteBuffer.allocateDirect(capacity);
+    ((Buffer) bb).flip();
+    bb2.put(bb);
+    bb = bb2;
+  }
+
+  @Override
+  public void write(int b)
+  {
+    reserve(1);
+    bb.put((byte) b);
+  }
+
+  @Override
+  public void write(byte[] b, int off, int len)
+  {
+    reserve(len);
+    bb.put(b, off, len);
+  }
+
+  /**
+   * Get a view of the contents written since the last reset.
+   *
+   * The view is only valid until the stream is written again.
+   *
+   * @return a buffer holding the contents.
+   */
+  public ByteBuffer view()
+  {
+    ByteBuffer out = bb.duplicate();
+    ((Buffer) out).flip();
+    return out;
+  }
+
+  /**
+   * Take the contents written so far.
+   *
+   * The stream starts a new buffer so the contents remain valid for as long
+   * as the returned buffer is referenced.
+   *
+   * @return a buffer holding the contents.
+   */
+  public ByteBuffer detach()
+  {
+    ByteBuffer out = view();
+    bb = ByteBuffer.allocateDirect(Math.max(INITIAL, out.limit()));
+    return out;
+  }
+
+  public void reset()
+  {
+    ((Buffer) bb).clear();
+  }
+}
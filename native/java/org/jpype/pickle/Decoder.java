@@ -17,6 +17,7 @@ package org.jpype.pickle;
 
 import java.io.IOException;
 import java.io.ObjectInputStream;
+import java.nio.ByteBuffer;
 
 public class Decoder
 {
@@ -32,6 +33,34 @@ public class Decoder
   public Object unpack(byte[] data) throws IOException, ClassNotFoundException
   {
     bb.put(data);
+    return read();
+  }
+
+  /**
+   * Deserialize an object from a buffer.
+   *
+   * The buffer may be a view of Python memory.  It is read in place and is
+   * not referenced after this call returns.
+   *
+   * @param data is the buffer holding the serialized form.
+   * @return the object.
+   * @throws IOException
+   * @throws ClassNotFoundException
+   */
+  public Object unpack(ByteBuffer data) throws IOException, ClassNotFoundException
+  {
+    bb.put(data);
+    try
+    {
+      return read();
+    } finally
+    {
+      bb.release();
+    }
+  }
+
+  private Object read() throws IOException, ClassNotFoundException
+  {
     if (ois == null)
       ois = new ObjectInputStream(bb);
     return ois.readObject();
@@ -15,9 +15,9 @@
 **************************************************************************** */
 package org.jpype.pickle;
 
-import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.ObjectOutputStream;
+import java.nio.ByteBuffer;
 
 /**
  *
@@ -26,21 +26,48 @@ import java.io.ObjectOutputStream;
 public class Encoder
 {
 
-  ByteArrayOutputStream baos;
+  ByteBufferOutputStream bbos;
   ObjectOutputStream oos;
+  boolean detach;
 
   public Encoder() throws IOException
   {
-    baos = new ByteArrayOutputStream();
-    oos = new ObjectOutputStream(baos);
+    this(false);
   }
 
-  public byte[] pack(Object obj) throws IOException
+  /**
+   * Create an encoder.
+   *
+   * @param detach is true if each packed buffer must remain valid after the
+   * next call to pack, as required for out-of-band pickle buffers.
+   * @throws IOException
+   */
+  public Encoder(boolean detach) throws IOException
+  {
+    this.detach = detach;
+    bbos = new ByteBufferOutputStream();
+    oos = new ObjectOutputStream(bbos);
+  }
+
+  /**
+   * Serialize an object.
+   *
+   * The result is a direct buffer so that Python can read it without a
+   * copy.  Unless the encoder was created to detach, the buffer is reused
+   * by the next call.
+   *
+   * @param obj is the object to serialize.
+   * @return a direct buffer holding the serialized form.
+   * @throws IOException
+   */
+  public ByteBuffer pack(Object obj) throws IOException
   {
     oos.writeObject(obj);
     oos.flush();
-    byte[] out = baos.toByteArray().clone();
-    baos.reset();
+    if (detach)
+      return bbos.detach();
+    ByteBuffer out = bbos.view();
+    bbos.reset();
     return out;
   }
 }
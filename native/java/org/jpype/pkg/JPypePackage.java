@@ -116,19 +116,8 @@ public class JPypePackage
       // If there is anything null, then skip it.
       if (uri == null)
         continue;
-      Path p = JPypePackageManager.getPath(uri);
-
-      // package are acceptable
-      if (Files.isDirectory(p))
+      if (JPypePackageManager.isVisible(pkg, key, uri))
         out.add(key);
-
-      // classes must be public
-      else if (uri.toString().endsWith(".class"))
-      {
-        // Make sure it is public
-        if (isPublic(p))
-          out.add(key);
-      }
     }
     return out.toArray(new String[out.size()]);
   }
@@ -153,74 +142,86 @@ public class JPypePackage
   {
     try (InputStream is = Files.newInputStream(p))
     {
-      // Allocate a three byte buffer for traversing the constant pool.
-      // The minumum entry is a byte for the type and 2 data bytes.  We
-      // will read these three bytes and then based on the type advance
-      // the read pointer to the next entry.
-      ByteBuffer buffer3 = ByteBuffer.allocate(3);
+      return isPublic(is);
+    } catch (IOException ex)
+    {
+      return false; // If anything goes wrong then it won't be considered a public class.
+    }
+  }
 
-      // Check the magic
-      ByteBuffer header = ByteBuffer.allocate(4 + 2 + 2 + 2);
-      is.read(header.array());
-      ((Buffer) header).rewind();
-      int magic = header.getInt();
-      if (magic != (int) 0xcafebabe)
-        return false;
-      header.getShort(); // skip major
-      header.getShort(); // skip minor
-      short cpitems = header.getShort(); // get the number of items
+  /**
+   * Determine if a class is public from the class file contents.
+   *
+   * @param is is a stream holding the class file.
+   * @return true if the class is public.
+   * @throws IOException if the stream cannot be read.
+   */
+  static boolean isPublic(InputStream is) throws IOException
+  {
+    // Allocate a three byte buffer for traversing the constant pool.
+    // The minumum entry is a byte for the type and 2 data bytes.  We
+    // will read these three bytes and then based on the type advance
+    // the read pointer to the next entry.
+    ByteBuffer buffer3 = ByteBuffer.allocate(3);
+
+    // Check the magic
+    ByteBuffer header = ByteBuffer.allocate(4 + 2 + 2 + 2);
+    is.read(header.array());
+    ((Buffer) header).rewind();
+    int magic = header.getInt();
+    if (magic != (int) 0xcafebabe)
+      return false;
+    header.getShort(); // skip major
+    header.getShort(); // skip minor
+    short cpitems = header.getShort(); // get the number of items
+
+    // Traverse the cp pool
+    for (int i = 0; i < cpitems - 1; ++i)
+    {
+      is.read(buffer3.array());
+      ((Buffer) buffer3).rewind();
+      byte type = buffer3.get(); // First byte is the type
 
-      // Traverse the cp pool
-      for (int i = 0; i < cpitems - 1; ++i)
+      // Now based on the entry type we will advance the pointer
+      switch (type)
       {
-        is.read(buffer3.array());
-        ((Buffer) buffer3).rewind();
-        byte type = buffer3.get(); // First byte is the type
-
-        // Now based on the entry type we will advance the pointer
-        switch (type)
-        {
-          case 1:  // Strings are variable length
-            is.skip(buffer3.getShort());
-            break;
-          case 7:
-          case 8:
-          case 16:
-          case 19:
-          case 20:
-            break;
-          case 15:
-            is.skip(1);
-            break;
-          case 3:
-          case 4:
-          case 9:
-          case 10:
-          case 11:
-          case 12:
-          case 17:
-          case 18:
-            is.skip(2);
-            break;
-          case 5:
-          case 6:
-            is.skip(6); // double and long are special as they are double entries
-            i++; // long and double take two slots
-            break;
-          default:
-            return false;
-        }
+        case 1:  // Strings are variable length
+          is.skip(buffer3.getShort());
+          break;
+        case 7:
+        case 8:
+        case 16:
+        case 19:
+        case 20:
+          break;
+        case 15:
+          is.skip(1);
+          break;
+        case 3:
+        case 4:
+        case 9:
+        case 10:
+        case 11:
+        case 12:
+        case 17:
+        case 18:
+          is.skip(2);
+          break;
+        case 5:
+        case 6:
+          is.skip(6); // double and long are special as they are double entries
+          i++; // long and double take two slots
+          break;
+        default:
+          return false;
       }
-
-      // Get the flags
-      is.read(buffer3.array());
-      ((Buffer) buffer3).rewind();
-      short flags = buffer3.getShort();
-      return (flags & 1) == 1; // it is public if bit zero is set
-    } catch (IOException ex)
-    {
-      return false; // If anything goes wrong then it won't be considered a public class.
     }
+
+    // Get the flags
+    is.read(buffer3.array());
+    ((Buffer) buffer3).rewind();
+    short flags = buffer3.getShort();
+    return (flags & 1) == 1; // it is public if bit zero is set
   }
   
   void checkCache()
@@ -49,6 +49,10 @@ import org.jpype.JPypeKeywords;
  * to be largely incorrect as the jar and jrt file system provide all the
  * required methods.
  *
+ * The jars on the class path are held in a PackageIndex so that probing a
+ * package does not need to reopen every jar. The index can be disabled by
+ * setting the system property "org.jpype.pkg.index" to false.
+ *
  */
 public class JPypePackageManager
 {
@@ -58,6 +62,8 @@ public class JPypePackageManager
   final static FileSystemProvider jfsp = getFileSystemProvider("jar");
   final static Map<String, String> env = new HashMap<>();
   final static LinkedList<FileSystem> fs = new LinkedList<>();
+  final static PackageIndex index = Boolean.parseBoolean(
+          System.getProperty("org.jpype.pkg.index", "true")) ? new PackageIndex() : null;
 
   /**
    * Checks if a package exists.
@@ -70,6 +76,12 @@ public class JPypePackageManager
   {
     if (name.indexOf('.') != -1)
       name = name.replace(".", "/");
+    if (index != null)
+    {
+      index.update(JPypeContext.getInstance().getClassLoader());
+      return index.isPackage(name) || isDirectoryPackage(name)
+              || isModulePackage(name) || isBasePackage(name);
+    }
     if (isModulePackage(name) || isBasePackage(name) || isJarPackage(name))
       return true;
     return false;
@@ -86,12 +98,46 @@ public class JPypePackageManager
     Map<String, URI> out = new HashMap<>();
     packageName = packageName.replace(".", "/");
     // We need to merge all the file systems into one view like the classloader
-    getJarContents(out, packageName);
+    if (index != null)
+    {
+      index.update(JPypeContext.getInstance().getClassLoader());
+      index.collect(out, packageName);
+      getDirectoryContents(out, packageName);
+    } else
+      getJarContents(out, packageName);
     getBaseContents(out, packageName);
     getModuleContents(out, packageName);
     return out;
   }
 
+  /**
+   * Check if a member of a package should be listed.
+   *
+   * Packages are always listed, but classes must be public.
+   *
+   * @param packageName is the name of the package.
+   * @param key is the name of the member.
+   * @param uri is the location of the member.
+   * @return true if the member should appear in the package contents.
+   */
+  static boolean isVisible(String packageName, String key, URI uri)
+  {
+    if (index != null)
+    {
+      Boolean visible = index.isVisible(packageName.replace(".", "/"), JPypeKeywords.unwrap(key));
+      if (visible != null)
+        return visible;
+    }
+    Path p = getPath(uri);
+
+    // package are acceptable
+    if (Files.isDirectory(p))
+      return true;
+
+    // classes must be public
+    return uri.toString().endsWith(".class") && JPypePackage.isPublic(p);
+  }
+
   /**
    * Convert a URI into a path.
    *
@@ -411,6 +457,44 @@ public class JPypePackageManager
     }
   }
 
+  /**
+   * Check if a name corresponds to a package in a directory on the class
+   * path.
+   *
+   * Used with the package index, which only holds the contents of jars.
+   *
+   * @param name is the name of the package to search for.
+   * @return true if the name corresponds to a Java package.
+   */
+  private static boolean isDirectoryPackage(String name)
+  {
+    if (name.isEmpty())
+      return false;
+    for (Path dir : index.getDirectories())
+    {
+      if (Files.isDirectory(dir.resolve(name)))
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * Retrieve a list of packages and classes stored in directories on the
+   * class path.
+   *
+   * @param out is the map to store the result in.
+   * @param packageName is the name of the package
+   */
+  private static void getDirectoryContents(Map<String, URI> out, String packageName)
+  {
+    for (Path dir : index.getDirectories())
+    {
+      Path path2 = dir.resolve(packageName);
+      if (Files.isDirectory(path2))
+        collectContents(out, path2);
+    }
+  }
+
 //</editor-fold>
 //<editor-fold desc="utility" defaultstate="collapsed">
   /**
@@ -0,0 +1,495 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+  
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.pkg;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStream;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.net.URL;
+import java.nio.file.FileSystemNotFoundException;
+import java.nio.file.Files;
+import java.nio.file.InvalidPathException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Enumeration;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.jar.Attributes;
+import java.util.jar.JarFile;
+import java.util.jar.Manifest;
+import java.util.stream.Collectors;
+import java.util.zip.ZipEntry;
+import org.jpype.JPypeKeywords;
+import org.jpype.classloader.DynamicClassLoader;
+
+/**
+ * In-memory index of the packages and classes held in the jars on the class
+ * path.
+ *
+ * Probing the class loader for a package requires opening every jar on the
+ * class path, which dominates import time once there are many jars. Instead
+ * we list the central directory of each jar once (in parallel) and keep a
+ * prefix tree of the packages and classes found. The index is extended when
+ * jars are added to the DynamicClassLoader. Directories on the class path are
+ * not indexed as their contents may change while running; they are probed
+ * directly by the package manager.
+ *
+ * The public flag of each class is read on first request and then cached, so
+ * listing a package never reopens an archive.
+ */
+class PackageIndex
+{
+
+  final Node root = new Node("");
+  final Set<String> sources = new HashSet<>();
+  final List<Path> directories = new ArrayList<>();
+  boolean built = false;
+  int code = 0;
+
+  /**
+   * A package in the index.
+   */
+  static class Node
+  {
+
+    final String path;
+    final Map<String, Node> packages = new HashMap<>();
+    final Map<String, Entry> classes = new HashMap<>();
+    Archive archive;
+
+    Node(String path)
+    {
+      this.path = path;
+    }
+  }
+
+  /**
+   * A jar which supplied entries to the index.
+   *
+   * The archive is held open so that class headers can be read on demand.
+   */
+  static class Archive
+  {
+
+    final URI uri;
+    final JarFile jar;
+
+    Archive(URI uri, JarFile jar)
+    {
+      this.uri = uri;
+      this.jar = jar;
+    }
+  }
+
+  /**
+   * A class file in the index.
+   */
+  static class Entry
+  {
+
+    final Archive archive;
+    final String name;
+    // 0 = unknown, 1 = public, 2 = not public
+    volatile byte access;
+
+    Entry(Archive archive, String name)
+    {
+      this.archive = archive;
+      this.name = name;
+    }
+
+    boolean isPublic()
+    {
+      if (access == 0)
+      {
+        boolean result = false;
+        ZipEntry ze = archive.jar.getEntry(name);
+        if (ze != null)
+        {
+          try (InputStream is = archive.jar.getInputStream(ze))
+          {
+            // Inflater streams may return short reads, so buffer the class
+            // file before parsing the constant pool.
+            ByteArrayOutputStream buffer = new ByteArrayOutputStream();
+            byte[] d = new byte[4096];
+            int bytes;
+            while ((bytes = is.read(d, 0, d.length)) != -1)
+            {
+              buffer.write(d, 0, bytes);
+            }
+            result = JPypePackage.isPublic(new ByteArrayInputStream(buffer.toByteArray()));
+          } catch (IOException ex)
+          {
+          }
+        }
+        access = (byte) (result ? 1 : 2);
+      }
+      return access == 1;
+    }
+
+    URI toURI()
+    {
+      return URI.create("jar:" + archive.uri + "!/" + name);
+    }
+  }
+
+  /**
+   * Result of listing one jar.
+   *
+   * Scans are produced in parallel and merged in class path order.
+   */
+  static class Scan
+  {
+
+    final Path path;
+    Archive archive;
+    final List<String> entries = new ArrayList<>();
+    final List<String> versioned = new ArrayList<>();
+    final List<Path> classPath = new ArrayList<>();
+
+    Scan(Path path)
+    {
+      this.path = path;
+    }
+  }
+
+  /**
+   * Bring the index up to date with the class path.
+   *
+   * The first call indexes the system class path. Later calls only index
+   * the jars added to the DynamicClassLoader since the previous call.
+   *
+   * @param cl is the class loader used by JPype.
+   */
+  synchronized void update(ClassLoader cl)
+  {
+    List<Path> paths = new ArrayList<>();
+    if (!built)
+    {
+      built = true;
+      addPathList(paths, System.getProperty("java.class.path"));
+      String ext = System.getProperty("java.ext.dirs");
+      if (ext != null)
+      {
+        for (String dir : ext.split(File.pathSeparator))
+        {
+          File[] jars = new File(dir).listFiles((d, n) -> n.endsWith(".jar"));
+          if (jars == null)
+            continue;
+          for (File jar : jars)
+          {
+            paths.add(jar.toPath());
+          }
+        }
+      }
+    }
+    if (cl instanceof DynamicClassLoader)
+    {
+      DynamicClassLoader dcl = (DynamicClassLoader) cl;
+      int current = dcl.getCode();
+      if (current != code)
+      {
+        code = current;
+        for (URL url : dcl.getURLs())
+        {
+          try
+          {
+            paths.add(Paths.get(url.toURI()));
+          } catch (URISyntaxException | IllegalArgumentException | FileSystemNotFoundException ex)
+          {
+          }
+        }
+      }
+    }
+    if (!paths.isEmpty())
+      add(paths);
+  }
+
+  /**
+   * Check if a package is held in an indexed jar.
+   *
+   * @param name is the package name using / as the separator.
+   * @return true if the package exists.
+   */
+  synchronized boolean isPackage(String name)
+  {
+    if (name.isEmpty())
+      return false;
+    return find(name) != null;
+  }
+
+  /**
+   * Add the contents of a package to a content map.
+   *
+   * @param out is the map to store the result in.
+   * @param name is the package name using / as the separator.
+   */
+  synchronized void collect(Map<String, URI> out, String name)
+  {
+    Node node = find(name);
+    if (node == null)
+      return;
+    for (Node child : node.packages.values())
+    {
+      String key = child.path.substring(child.path.lastIndexOf('/') + 1);
+      out.put(JPypeKeywords.wrap(key),
+              URI.create("jar:" + child.archive.uri + "!/" + child.path + "/"));
+    }
+    for (Map.Entry<String, Entry> e : node.classes.entrySet())
+    {
+      out.put(JPypeKeywords.wrap(e.getKey()), e.getValue().toURI());
+    }
+  }
+
+  /**
+   * Check if a member of a package should be listed.
+   *
+   * @param name is the package name using / as the separator.
+   * @param key is the name of the member.
+   * @return TRUE for a package or a public class, FALSE for a class which is
+   * not public, or null if the member is not in the index.
+   */
+  Boolean isVisible(String name, String key)
+  {
+    Entry entry;
+    synchronized (this)
+    {
+      Node node = find(name);
+      if (node == null)
+        return null;
+      if (node.packages.containsKey(key))
+        return Boolean.TRUE;
+      entry = node.classes.get(key);
+      if (entry == null)
+        return null;
+    }
+    return entry.isPublic();
+  }
+
+  /**
+   * Get the directories found on the class path.
+   *
+   * @return a copy of the list of directories.
+   */
+  synchronized List<Path> getDirectories()
+  {
+    return new ArrayList<>(directories);
+  }
+
+//<editor-fold desc="internal" defaultstate="collapsed">
+  private Node find(String name)
+  {
+    Node node = root;
+    if (name.isEmpty())
+      return node;
+    for (String part : name.split("/"))
+    {
+      node = node.packages.get(part);
+      if (node == null)
+        return null;
+    }
+    return node;
+  }
+
+  private Node getNode(String name, Archive archive)
+  {
+    Node node = root;
+    int start = 0;
+    while (start < name.length())
+    {
+      int end = name.indexOf('/', start);
+      if (end == -1)
+        end = name.length();
+      String part = name.substring(start, end);
+      Node next = node.packages.get(part);
+      if (next == null)
+      {
+        next = new Node(name.substring(0, end));
+        next.archive = archive;
+        node.packages.put(part, next);
+      }
+      node = next;
+      start = end + 1;
+    }
+    return node;
+  }
+
+  private static void addPathList(List<Path> paths, String list)
+  {
+    if (list == null || list.isEmpty())
+      return;
+    for (String s : list.split(File.pathSeparator))
+    {
+      if (s.isEmpty())
+        continue;
+      try
+      {
+        paths.add(Paths.get(s));
+      } catch (InvalidPathException ex)
+      {
+      }
+    }
+  }
+
+  /**
+   * Index a list of paths.
+   *
+   * Jars are listed in parallel and then merged in order so that the first
+   * jar holding a class supplies it, matching the class loader. Jars named by
+   * a manifest Class-Path are followed.
+   */
+  private void add(List<Path> paths)
+  {
+    while (!paths.isEmpty())
+    {
+      List<Path> jars = new ArrayList<>();
+      for (Path path : paths)
+      {
+        Path abs = path.toAbsolutePath().normalize();
+        if (!sources.add(abs.toString()))
+          continue;
+        if (Files.isDirectory(abs))
+          directories.add(abs);
+        else if (Files.isRegularFile(abs))
+          jars.add(abs);
+      }
+
+      List<Scan> scans = jars.parallelStream()
+              .map(PackageIndex::scan)
+              .collect(Collectors.toList());
+
+      paths = new ArrayList<>();
+      for (Scan scan : scans)
+      {
+        if (scan.archive == null)
+          continue;
+        merge(scan);
+        paths.addAll(scan.classPath);
+      }
+    }
+  }
+
+  private void merge(Scan scan)
+  {
+    for (String entry : scan.entries)
+    {
+      addEntry(scan.archive, entry, entry);
+    }
+    // MRJAR overlays only supply classes missing from the base
+    for (String entry : scan.versioned)
+    {
+      int i = entry.indexOf('/', 18);
+      addEntry(scan.archive, entry.substring(i + 1), entry);
+    }
+  }
+
+  private void addEntry(Archive archive, String name, String entry)
+  {
+    if (name.isEmpty())
+      return;
+    int i = name.lastIndexOf('/');
+    if (entry.endsWith("/"))
+    {
+      getNode(name.substring(0, name.length() - 1), archive);
+      return;
+    }
+    if (i == -1)
+      return;
+    Node node = getNode(name.substring(0, i), archive);
+    String filename = name.substring(i + 1);
+
+    // Skip inner classes
+    if (!filename.endsWith(".class") || filename.contains("$"))
+      return;
+    filename = filename.substring(0, filename.length() - 6);
+    node.classes.putIfAbsent(filename, new Entry(archive, entry));
+  }
+
+  /**
+   * List the entries of a jar.
+   *
+   * This only reads the central directory and manifest.
+   *
+   * @param path is the jar to list.
+   * @return the scan, with a null archive if the file was not a jar.
+   */
+  private static Scan scan(Path path)
+  {
+    Scan scan = new Scan(path);
+    JarFile jar = null;
+    try
+    {
+      jar = new JarFile(path.toFile(), false);
+      Enumeration<? extends ZipEntry> entries = jar.entries();
+      while (entries.hasMoreElements())
+      {
+        String name = entries.nextElement().getName();
+        if (name.startsWith("META-INF/"))
+        {
+          if (name.startsWith("META-INF/versions/") && name.indexOf('/', 18) != -1)
+            scan.versioned.add(name);
+          continue;
+        }
+        scan.entries.add(name);
+      }
+
+      // Follow the manifest class path
+      Manifest manifest = jar.getManifest();
+      if (manifest != null)
+      {
+        String cp = manifest.getMainAttributes().getValue(Attributes.Name.CLASS_PATH);
+        if (cp != null)
+        {
+          Path parent = path.getParent();
+          for (String s : cp.trim().split("\\s+"))
+          {
+            try
+            {
+              Path p = Paths.get(parent.toUri().resolve(s));
+              if (Files.exists(p))
+                scan.classPath.add(p);
+            } catch (IllegalArgumentException | FileSystemNotFoundException ex)
+            {
+            }
+          }
+        }
+      }
+      scan.archive = new Archive(path.toUri(), jar);
+    } catch (IOException ex)
+    {
+      // Not a jar, skip it
+      if (jar != null)
+      {
+        try
+        {
+          jar.close();
+        } catch (IOException ex2)
+        {
+        }
+      }
+    }
+    return scan;
+  }
+//</editor-fold>
+}
@@ -345,6 +345,7 @@ public:
 	~JPPyCallAcquire();
 private:
 	long m_State;
+	bool m_Traced;
 } ;
 
 /** Used when leaving python to an external potentially
@@ -357,8 +358,26 @@ public:
 	JPPyCallRelease();
 	/** Reacquire the lock. */
 	~JPPyCallRelease();
+
+	/**
+	 * Keep the lock for the next release scope on this thread.
+	 *
+	 * This is used by methods that are known to be short so that they do
+	 * not pay to release and reacquire the lock.  The request is consumed
+	 * by the next scope, or cleared by calling with false.
+	 */
+	static void hold(bool keep);
+
+	/**
+	 * Get the total time this thread has waited to reacquire the lock.
+	 *
+	 * This is only kept while statistics or adaptive release are enabled.
+	 */
+	static long long getWaitTime();
 private:
 	void* m_State1;
+	long long m_Start;
+	bool m_Traced;
 } ;
 
 class JPPyBuffer
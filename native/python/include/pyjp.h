@@ -31,7 +31,7 @@ class JPStackInfo;
 #define JP_PY_CATCH_NONE(...)  } catch(...) {} return __VA_ARGS__
 #else
 #ifndef JP_INSTRUMENTATION
-#define JP_PY_TRY(...)  try { do {} while(0)
+#define JP_PY_TRY(...)  JPTraceScope _trace(__VA_ARGS__); try { do {} while(0)
 #else
 #define JP_PY_TRY(...)  JP_TRACE_IN(__VA_ARGS__)
 #endif
@@ -128,7 +128,9 @@ extern PyTypeObject *PyJPArrayPrimitive_Type;
 extern PyTypeObject *PyJPBuffer_Type;
 extern PyTypeObject *PyJPClass_Type;
 extern PyTypeObject *PyJPComparable_Type;
+extern PyTypeObject *PyJPField_Type;
 extern PyTypeObject *PyJPMethod_Type;
+extern PyTypeObject *PyJPOverload_Type;
 extern PyTypeObject *PyJPObject_Type;
 extern PyTypeObject *PyJPProxy_Type;
 extern PyTypeObject *PyJPException_Type;
@@ -176,6 +178,7 @@ JPValue   *PyJPValue_getJavaSlot(PyObject* obj);
 
 // Access point for creating classes
 PyObject  *PyJPModule_getClass(PyObject* module, PyObject *obj);
+PyObject  *PyJPField_readFields(PyObject *module, PyObject *args);
 PyObject  *PyJPValue_getattro(PyObject *obj, PyObject *name);
 int        PyJPValue_setattro(PyObject *self, PyObject *name, PyObject *value);
 void       PyJPClass_hook(JPJavaFrame &frame, JPClass* cls);
@@ -192,6 +195,7 @@ JPPyObject PyJPClass_create(JPJavaFrame &frame, JPClass* cls);
 JPPyObject PyJPNumber_create(JPJavaFrame &frame, JPPyObject& wrapper, const JPValue& value);
 JPPyObject PyJPField_create(JPField* m);
 JPPyObject PyJPMethod_create(JPMethodDispatch *m, PyObject *instance);
+JPPyObject PyJPOverload_create(JPMethodDispatch *m, JPMethod *overload, PyObject *instance);
 
 JPClass*   PyJPClass_getJPClass(PyObject* obj);
 JPProxy*   PyJPProxy_getJPProxy(PyObject* obj);
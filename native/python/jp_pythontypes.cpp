@@ -391,25 +391,76 @@ int m_count = 0;
 JPPyCallAcquire::JPPyCallAcquire()
 {
 	m_State = (long) PyGILState_Ensure();
+	m_Traced = _jp_trace_events != 0;
+	if (m_Traced)
+		JPTraceEvents::begin("python", JPTraceEvents::_transition);
 }
 
 JPPyCallAcquire::~JPPyCallAcquire()
 {
+	if (m_Traced)
+		JPTraceEvents::end("python", JPTraceEvents::_transition);
 	PyGILState_Release((PyGILState_STATE) m_State);
 }
 
 // This is used when leaving python from to perform some
 
+static thread_local bool jp_gil_hold = false;
+static thread_local long long jp_gil_wait = 0;
+
+void JPPyCallRelease::hold(bool keep)
+{
+	jp_gil_hold = keep;
+}
+
+long long JPPyCallRelease::getWaitTime()
+{
+	return jp_gil_wait;
+}
+
 JPPyCallRelease::JPPyCallRelease()
 {
+	if (jp_gil_hold)
+	{
+		// The caller asked to keep the lock for this call
+		jp_gil_hold = false;
+		m_State1 = NULL;
+		m_Start = 0;
+		m_Traced = false;
+		JP_STAT_INC(JPStat_gilHeld);
+		return;
+	}
+
 	// Release the lock and set the thread state to NULL
 	m_State1 = (void*) PyEval_SaveThread();
+	m_Start = (_jp_stats_enabled || _jp_gil_adaptive) ? JPStats_clock() : 0;
+	m_Traced = _jp_trace_events != 0;
+	if (m_Traced)
+		JPTraceEvents::begin("java", JPTraceEvents::_transition);
 }
 
 JPPyCallRelease::~JPPyCallRelease()
 {
+	if (m_State1 == NULL)
+		return;
+	if (m_Traced)
+		JPTraceEvents::end("java", JPTraceEvents::_transition);
 	// Reaquire the lock
 	PyThreadState *save = (PyThreadState *) m_State1;
+	if (m_Start != 0)
+	{
+		long long wait = JPStats_clock();
+		PyEval_RestoreThread(save);
+		long long end = JPStats_clock();
+		jp_gil_wait += end - wait;
+		if (_jp_stats_enabled)
+		{
+			JPStats_add(JPStat_gilReleases, 1);
+			JPStats_add(JPStat_gilReleaseTime, end - m_Start);
+			JPStats_add(JPStat_gilWaitTime, end - wait);
+		}
+		return;
+	}
 	PyEval_RestoreThread(save);
 }
 
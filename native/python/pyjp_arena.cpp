@@ -0,0 +1,231 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_arena.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct PyJPArena
+{
+	PyObject_HEAD
+	JPArena *m_Arena;
+} ;
+
+static int PyJPArena_init(PyJPArena *self, PyObject *args, PyObject *kwargs)
+{
+	JP_PY_TRY("PyJPArena_init");
+	// Calling __init__ again replaces the arena, so close the old one
+	if (self->m_Arena != NULL)
+		self->m_Arena->close();
+	self->m_Arena = NULL;
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+
+	static const char *kwlist[] = {"size", "hugepages", NULL};
+	Py_ssize_t size;
+	int hugePages = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|p", (char**) kwlist, &size, &hugePages))
+		return -1;
+	if (size <= 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "arena size must be positive");
+		return -1;
+	}
+
+	self->m_Arena = new JPArena(frame, size, hugePages != 0);
+	return 0;
+	JP_PY_CATCH(-1);
+}
+
+static void PyJPArena_dealloc(PyJPArena *self)
+{
+	JP_PY_TRY("PyJPArena_dealloc");
+	if (self->m_Arena != NULL)
+		self->m_Arena->close();
+	self->m_Arena = NULL;
+	Py_TYPE(self)->tp_free(self);
+	JP_PY_CATCH(); // GCOVR_EXCL_LINE
+}
+
+static JPArena *PyJPArena_get(PyJPArena *self)
+{
+	if (self->m_Arena == NULL || self->m_Arena->isClosed())
+		JP_RAISE(PyExc_ValueError, "arena is closed");
+	return self->m_Arena;
+}
+
+static PyObject *PyJPArena_repr(PyJPArena *self)
+{
+	JP_PY_TRY("PyJPArena_repr");
+	if (self->m_Arena == NULL || self->m_Arena->isClosed())
+		return PyUnicode_FromFormat("<java arena closed>");
+	return PyUnicode_FromFormat("<java arena %zd/%zd bytes>",
+			(Py_ssize_t) self->m_Arena->getUsed(), (Py_ssize_t) self->m_Arena->getSize());
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_allocate(PyJPArena *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPArena_allocate");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPArena *arena = PyJPArena_get(self);
+	Py_ssize_t size = PyNumber_AsSsize_t(arg, PyExc_OverflowError);
+	JP_PY_CHECK();
+	if (size < 0)
+		JP_RAISE(PyExc_ValueError, "size must not be negative");
+
+	jvalue v;
+	v.l = arena->allocate(frame, size);
+
+	// All slices share a class so the lookup is only needed once
+	JPClass *type = arena->getBufferClass();
+	if (type == NULL)
+	{
+		type = frame.findClassForObject(v.l);
+		arena->setBufferClass(type);
+	}
+	return type->convertToPythonObject(frame, v, false).keep();
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_release(PyJPArena *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPArena_release");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPArena *arena = PyJPArena_get(self);
+	JPValue *value = PyJPValue_getJavaSlot(arg);
+	if (value == NULL || value->getClass()->isPrimitive() || value->getValue().l == NULL)
+		JP_RAISE(PyExc_TypeError, "Java buffer is required");
+	arena->release(frame, value->getValue().l);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_advance(PyJPArena *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPArena_advance");
+	return PyLong_FromSize_t(PyJPArena_get(self)->advance());
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_reclaim(PyJPArena *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPArena_reclaim");
+	size_t epoch = PyLong_AsSize_t(arg);
+	JP_PY_CHECK();
+	return PyLong_FromSize_t(PyJPArena_get(self)->reclaim(epoch));
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_close(PyJPArena *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPArena_close");
+	// Closing drops our share, so the arena may be deleted once Java
+	// collects the backing buffer
+	if (self->m_Arena != NULL)
+		self->m_Arena->close();
+	self->m_Arena = NULL;
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_enter(PyJPArena *self, PyObject *args)
+{
+	Py_INCREF(self);
+	return (PyObject*) self;
+}
+
+static PyObject *PyJPArena_getSize(PyJPArena *self, void *closure)
+{
+	JP_PY_TRY("PyJPArena_getSize");
+	return PyLong_FromSize_t(PyJPArena_get(self)->getSize());
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_getUsed(PyJPArena *self, void *closure)
+{
+	JP_PY_TRY("PyJPArena_getUsed");
+	return PyLong_FromSize_t(PyJPArena_get(self)->getUsed());
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_getEpoch(PyJPArena *self, void *closure)
+{
+	JP_PY_TRY("PyJPArena_getEpoch");
+	return PyLong_FromSize_t(PyJPArena_get(self)->getEpoch());
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArena_getClosed(PyJPArena *self, void *closure)
+{
+	return PyBool_FromLong(self->m_Arena == NULL || self->m_Arena->isClosed());
+}
+
+static PyMethodDef arenaMethods[] = {
+	{"allocate", (PyCFunction) (&PyJPArena_allocate), METH_O, ""},
+	{"release", (PyCFunction) (&PyJPArena_release), METH_O, ""},
+	{"advance", (PyCFunction) (&PyJPArena_advance), METH_NOARGS, ""},
+	{"reclaim", (PyCFunction) (&PyJPArena_reclaim), METH_O, ""},
+	{"close", (PyCFunction) (&PyJPArena_close), METH_NOARGS, ""},
+	{"__enter__", (PyCFunction) (&PyJPArena_enter), METH_NOARGS, ""},
+	{"__exit__", (PyCFunction) (&PyJPArena_close), METH_VARARGS, ""},
+	{NULL},
+};
+
+static PyGetSetDef arenaGetSets[] = {
+	{"size", (getter) (&PyJPArena_getSize), NULL, NULL},
+	{"used", (getter) (&PyJPArena_getUsed), NULL, NULL},
+	{"epoch", (getter) (&PyJPArena_getEpoch), NULL, NULL},
+	{"closed", (getter) (&PyJPArena_getClosed), NULL, NULL},
+	{0}
+};
+
+static PyType_Slot arenaSlots[] = {
+	{ Py_tp_init,     (void*) PyJPArena_init},
+	{ Py_tp_dealloc,  (void*) PyJPArena_dealloc},
+	{ Py_tp_repr,     (void*) PyJPArena_repr},
+	{ Py_tp_methods,  (void*) &arenaMethods},
+	{ Py_tp_getset,   (void*) &arenaGetSets},
+	{0}
+};
+
+PyType_Spec PyJPArenaSpec = {
+	"_jpype._JArena",
+	sizeof (PyJPArena),
+	0,
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	arenaSlots
+};
+
+PyTypeObject* PyJPArena_Type = NULL;
+
+#ifdef __cplusplus
+}
+#endif
+
+void PyJPArena_initType(PyObject* module)
+{
+	PyJPArena_Type = (PyTypeObject*) PyType_FromSpec(&PyJPArenaSpec);
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+	PyModule_AddObject(module, "_JArena", (PyObject*) PyJPArena_Type);
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+}
@@ -410,6 +410,286 @@ int PyJPArrayPrimitive_getBuffer(PyJPArray *self, Py_buffer *view, int flags)
 	JP_PY_CATCH(-1);
 }
 
+/**
+ * Buffer over the contents of a primitive array.
+ *
+ * This is created with an explicit mode so that the caller chooses whether
+ * the memory is shared with Java or owned by Python.
+ */
+struct PyJPArrayBuffer
+{
+	PyObject_HEAD
+	PyObject *m_Owner;
+	JPArrayView *m_View;
+	char *m_Allocation;
+	char *m_Memory;
+	int m_Mode;
+	int m_Exports;
+	Py_ssize_t m_Length;
+	Py_ssize_t m_ItemSize;
+	const char *m_Format;
+} ;
+
+enum
+{
+	_arrayBufferPin = 0,
+	_arrayBufferCopy = 1,
+	_arrayBufferDetach = 2
+} ;
+
+static const char *arrayBufferModes[] = {"pin", "copy", "detach"};
+
+PyTypeObject *PyJPArrayBuffer_Type = NULL;
+
+// Align the Python owned memory for vectorized consumers
+static const size_t JP_ARRAY_BUFFER_ALIGN = 64;
+
+static void PyJPArrayBuffer_copy(JPJavaFrame &frame, PyJPArrayBuffer *self)
+{
+	JPArray *array = ((PyJPArray*) self->m_Owner)->m_Array;
+	JPPrimitiveType *type = (JPPrimitiveType*) array->getClass()->getComponentType();
+	jsize length = (jsize) self->m_Length;
+	jsize start = array->getStart();
+	jsize step = array->getStep();
+	if (length == 0)
+		return;
+	if (step == 1)
+	{
+		type->copyElements(frame, array->getJava(), start, length, self->m_Memory, 0);
+	} else
+	{
+		// Read the span covered by the slice and gather the elements
+		jsize first = (step > 0) ? start : start + step * (length - 1);
+		jsize span = (step > 0 ? step : -step) * (length - 1) + 1;
+		std::vector<char> tmp((size_t) (span * self->m_ItemSize));
+		type->copyElements(frame, array->getJava(), first, span, &tmp[0], 0);
+		char *src = &tmp[0] + (start - first) * self->m_ItemSize;
+		for (jsize i = 0; i < length; ++i)
+		{
+			memcpy(self->m_Memory + i * self->m_ItemSize, src, self->m_ItemSize);
+			src += step * self->m_ItemSize;
+		}
+	}
+	JP_STAT_ADD(JPStat_arrayCopyBytes, self->m_Length * self->m_ItemSize);
+}
+
+static PyObject *PyJPArrayBuffer_create(PyJPArray *array, int mode)
+{
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	if (array->m_Array == NULL)
+		JP_RAISE(PyExc_ValueError, "Null array"); // GCOVR_EXCL_LINE
+	JPPrimitiveType *type = (JPPrimitiveType*) array->m_Array->getClass()->getComponentType();
+
+	JPPyObject out = JPPyObject::call(PyJPArrayBuffer_Type->tp_alloc(PyJPArrayBuffer_Type, 0));
+	PyJPArrayBuffer *self = (PyJPArrayBuffer*) out.get();
+	self->m_Owner = (PyObject*) array;
+	Py_INCREF(self->m_Owner);
+	self->m_View = NULL;
+	self->m_Allocation = NULL;
+	self->m_Memory = NULL;
+	self->m_Mode = mode;
+	self->m_Exports = 0;
+	self->m_Length = array->m_Array->getLength();
+	self->m_ItemSize = type->getItemSize();
+	self->m_Format = type->getBufferFormat();
+	if (mode == _arrayBufferPin)
+		return out.keep();
+
+	self->m_Allocation = new char[self->m_Length * self->m_ItemSize + JP_ARRAY_BUFFER_ALIGN];
+	size_t misalign = ((size_t) self->m_Allocation) % JP_ARRAY_BUFFER_ALIGN;
+	self->m_Memory = self->m_Allocation + (misalign ? JP_ARRAY_BUFFER_ALIGN - misalign : 0);
+	PyJPArrayBuffer_copy(frame, self);
+	if (mode == _arrayBufferDetach)
+		Py_CLEAR(self->m_Owner);
+	return out.keep();
+}
+
+static void PyJPArrayBuffer_unpin(PyJPArrayBuffer *self)
+{
+	if (self->m_View == NULL)
+		return;
+	JPContext* context = JPContext_global;
+	if (context->isRunning())
+	{
+		JPJavaFrame frame = JPJavaFrame::outer(context);
+		self->m_View->unreference();
+	}
+	delete self->m_View;
+	self->m_View = NULL;
+}
+
+static void PyJPArrayBuffer_dealloc(PyJPArrayBuffer *self)
+{
+	JP_PY_TRY("PyJPArrayBuffer_dealloc");
+	PyJPArrayBuffer_unpin(self);
+	delete [] self->m_Allocation;
+	Py_CLEAR(self->m_Owner);
+	Py_TYPE(self)->tp_free(self);
+	JP_PY_CATCH(); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPArrayBuffer_repr(PyJPArrayBuffer *self)
+{
+	JP_PY_TRY("PyJPArrayBuffer_repr");
+	return PyUnicode_FromFormat("<java array buffer '%s'>", arrayBufferModes[self->m_Mode]);
+	JP_PY_CATCH(0); // GCOVR_EXCL_LINE
+}
+
+static void PyJPArrayBuffer_releaseBuffer(PyJPArrayBuffer *self, Py_buffer *view)
+{
+	JP_PY_TRY("PyJPArrayBuffer_releaseBuffer");
+	self->m_Exports--;
+	// Pins are held only while exported
+	if (self->m_Exports == 0)
+		PyJPArrayBuffer_unpin(self);
+	JP_PY_CATCH(); // GCOVR_EXCL_LINE
+}
+
+static int PyJPArrayBuffer_getBuffer(PyJPArrayBuffer *self, Py_buffer *view, int flags)
+{
+	JP_PY_TRY("PyJPArrayBuffer_getBuffer");
+	view->obj = NULL;
+	view->buf = self->m_Memory;
+	view->len = self->m_Length * self->m_ItemSize;
+	view->itemsize = self->m_ItemSize;
+	view->readonly = 0;
+	view->ndim = 1;
+	view->format = (char*) self->m_Format;
+	view->shape = &self->m_Length;
+	view->strides = &self->m_ItemSize;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+
+	if (self->m_Mode == _arrayBufferPin)
+	{
+		if ((flags & PyBUF_WRITEABLE) == PyBUF_WRITEABLE)
+		{
+			PyErr_SetString(PyExc_BufferError, "Pinned Java array buffer is not writable");
+			return -1;
+		}
+		JPContext *context = PyJPModule_getContext();
+		JPJavaFrame frame = JPJavaFrame::outer(context);
+		if (self->m_View == NULL)
+		{
+			PyJPArray *array = (PyJPArray*) self->m_Owner;
+			self->m_View = new JPArrayView(array->m_Array);
+			self->m_View->reference();
+			JP_STAT_INC(JPStat_arrayPins);
+			if (self->m_View->m_IsCopy)
+				JP_STAT_INC(JPStat_arrayPinCopies);
+		}
+		Py_buffer &pinned = self->m_View->m_Buffer;
+		view->buf = pinned.buf;
+		view->readonly = 1;
+		view->strides = pinned.strides;
+		if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && view->strides[0] != view->itemsize)
+		{
+			if (self->m_Exports == 0)
+				PyJPArrayBuffer_unpin(self);
+			PyErr_SetString(PyExc_BufferError, "slices required strides");
+			return -1;
+		}
+	}
+
+	if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+		view->strides = NULL;
+	if ((flags & PyBUF_ND) != PyBUF_ND)
+		view->shape = NULL;
+	if ((flags & PyBUF_FORMAT) != PyBUF_FORMAT)
+		view->format = NULL;
+
+	self->m_Exports++;
+	view->obj = (PyObject*) self;
+	Py_INCREF(view->obj);
+	return 0;
+	JP_PY_CATCH(-1);
+}
+
+static PyObject *PyJPArrayBuffer_refresh(PyJPArrayBuffer *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPArrayBuffer_refresh");
+	if (self->m_Mode != _arrayBufferCopy)
+	{
+		PyErr_SetString(PyExc_ValueError, "Only copy buffers can be refreshed");
+		return NULL;
+	}
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	PyJPArrayBuffer_copy(frame, self);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject *PyJPArrayBuffer_getMode(PyJPArrayBuffer *self, void *closure)
+{
+	return PyUnicode_FromString(arrayBufferModes[self->m_Mode]);
+}
+
+static PyObject *PyJPArrayBuffer_getArray(PyJPArrayBuffer *self, void *closure)
+{
+	PyObject *out = self->m_Owner ? self->m_Owner : Py_None;
+	Py_INCREF(out);
+	return out;
+}
+
+static PyMethodDef arrayBufferMethods[] = {
+	{"refresh", (PyCFunction) (&PyJPArrayBuffer_refresh), METH_NOARGS, ""},
+	{NULL},
+};
+
+static PyGetSetDef arrayBufferGetSets[] = {
+	{"mode", (getter) (&PyJPArrayBuffer_getMode), NULL, NULL},
+	{"array", (getter) (&PyJPArrayBuffer_getArray), NULL, NULL},
+	{0}
+};
+
+static PyType_Slot arrayBufferSlots[] = {
+	{ Py_tp_dealloc,  (void*) PyJPArrayBuffer_dealloc},
+	{ Py_tp_repr,     (void*) PyJPArrayBuffer_repr},
+	{ Py_tp_methods,  (void*) &arrayBufferMethods},
+	{ Py_tp_getset,   (void*) &arrayBufferGetSets},
+	{0}
+};
+
+static PyBufferProcs arrayBufferBuffer = {
+	(getbufferproc) & PyJPArrayBuffer_getBuffer,
+	(releasebufferproc) & PyJPArrayBuffer_releaseBuffer
+};
+
+static PyType_Spec arrayBufferSpec = {
+	"_jpype._JArrayBuffer",
+	sizeof (PyJPArrayBuffer),
+	0,
+	Py_TPFLAGS_DEFAULT,
+	arrayBufferSlots
+};
+
+static const char *toBuffer_doc =
+		"Get a buffer over the contents of a primitive array.\n"
+		"\n"
+		"Args:\n"
+		"  mode (str): ``\"pin\"`` shares the Java memory while the buffer\n"
+		"    is exported, ``\"copy\"`` copies into aligned Python memory and\n"
+		"    can be refreshed, ``\"detach\"`` copies and drops the array.\n";
+
+static PyObject *PyJPArrayPrimitive_toBuffer(PyJPArray *self, PyObject *args, PyObject *kwargs)
+{
+	JP_PY_TRY("PyJPArrayPrimitive_toBuffer");
+	const char *mode = "copy";
+	static const char *kwlist[] = {"mode", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", (char**) kwlist, &mode))
+		return NULL;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (strcmp(mode, arrayBufferModes[i]) == 0)
+			return PyJPArrayBuffer_create(self, i);
+	}
+	PyErr_Format(PyExc_ValueError, "Unknown buffer mode '%s'", mode);
+	return NULL;
+	JP_PY_CATCH(NULL);
+}
+
 static const char *length_doc =
 		"Get the length of a Java array\n"
 		"\n"
@@ -458,7 +738,13 @@ static PyBufferProcs arrayPrimBuffer = {
 	(releasebufferproc) & PyJPArray_releaseBuffer
 };
 
+static PyMethodDef arrayPrimMethods[] = {
+	{"toBuffer", (PyCFunction) (&PyJPArrayPrimitive_toBuffer), METH_VARARGS | METH_KEYWORDS, toBuffer_doc},
+	{NULL},
+};
+
 static PyType_Slot arrayPrimSlots[] = {
+	{ Py_tp_methods,  (void*) &arrayPrimMethods},
 	{0}
 };
 
@@ -492,6 +778,12 @@ void PyJPArray_initType(PyObject * module)
 	PyModule_AddObject(module, "_JArrayPrimitive",
 			(PyObject*) PyJPArrayPrimitive_Type);
 	JP_PY_CHECK();
+
+	PyJPArrayBuffer_Type = (PyTypeObject*) PyType_FromSpec(&arrayBufferSpec);
+	JP_PY_CHECK();
+	PyJPArrayBuffer_Type->tp_as_buffer = &arrayBufferBuffer;
+	PyModule_AddObject(module, "_JArrayBuffer", (PyObject*) PyJPArrayBuffer_Type);
+	JP_PY_CHECK();
 }
 
 JPPyObject PyJPArray_create(JPJavaFrame &frame, PyTypeObject *type, const JPValue & value)
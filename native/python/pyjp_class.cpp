@@ -570,8 +570,7 @@ static int PyJPClass_setClass(PyObject *self, PyObject *type, PyObject *closure)
 
 	JPClass* cls = frame.findClass((jclass) javaSlot->getJavaObject());
 	JP_TRACE("Set host", cls, javaSlot->getClass()->getCanonicalName().c_str());
-	if (cls->getHost() == NULL)
-		cls->setHost(self);
+	cls->setHost(self);
 	((PyJPClass*) self)->m_Class = cls;
 	return 0;
 	JP_PY_CATCH(-1);
@@ -1199,8 +1198,10 @@ void PyJPClass_hook(JPJavaFrame &frame, JPClass* cls)
 			(jobject) self->m_Class->getJavaClass()));
 
 	// Attach the cache  (adds reference, thus wrapper lives to end of JVM)
+	// If another thread published a wrapper first, ours is discarded.
 	JP_TRACE("set host");
-	cls->setHost((PyObject*) self);
+	if (!cls->setHost((PyObject*) self))
+		return;
 
 	// Call the post load routine to attach inner classes
 	JP_TRACE("call post");
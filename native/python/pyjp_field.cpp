@@ -43,14 +43,14 @@ static PyObject *PyJPField_get(PyJPField *self, PyObject *obj, PyObject *type)
 	if (hasInterrupt())
 		frame.clearInterrupt(false);
 	if (self->m_Field->isStatic())
-		return self->m_Field->getStaticField().keep();
+		return self->m_Field->getStaticField(frame).keep();
 	if (obj == NULL)
 		JP_RAISE(PyExc_AttributeError, "Field is not static");
 	JPValue *jval = PyJPValue_getJavaSlot(obj);
 	if (jval == NULL)
 		JP_RAISE(PyExc_AttributeError, "Field requires instance value");
 
-	return self->m_Field->getField(jval->getValue().l).keep();
+	return self->m_Field->getField(frame, jval->getValue().l).keep();
 	JP_PY_CATCH(NULL);
 }
 
@@ -66,7 +66,7 @@ static int PyJPField_set(PyJPField *self, PyObject *obj, PyObject *pyvalue)
 	}
 	if (self->m_Field->isStatic())
 	{
-		self->m_Field->setStaticField(pyvalue);
+		self->m_Field->setStaticField(frame, pyvalue);
 		return 0;
 	}
 	if (obj == Py_None || PyJPClass_Check(obj))
@@ -80,7 +80,7 @@ static int PyJPField_set(PyJPField *self, PyObject *obj, PyObject *pyvalue)
 		PyErr_Format(PyExc_AttributeError, "Field requires instance value, not '%s'", Py_TYPE(obj)->tp_name);
 		return -1;
 	}
-	self->m_Field->setField(jval->getValue().l, pyvalue);
+	self->m_Field->setField(frame, jval->getValue().l, pyvalue);
 	return 0;
 	JP_PY_CATCH(-1);
 }
@@ -97,6 +97,103 @@ static PyObject *PyJPField_repr(PyJPField *self)
 	JP_PY_CATCH(NULL);
 }
 
+/**
+ * Find the instance field descriptors for a tuple of names on a wrapper type.
+ */
+static void PyJPField_resolve(PyTypeObject *type, PyObject *names, vector<JPField*> &fields)
+{
+	fields.clear();
+	PyObject *mro = type->tp_mro;
+	Py_ssize_t n = PyTuple_Size(names);
+	for (Py_ssize_t i = 0; i < n; ++i)
+	{
+		PyObject *name = PyTuple_GetItem(names, i);
+		if (!PyUnicode_Check(name))
+			JP_RAISE(PyExc_TypeError, "field names must be strings");
+		PyObject *desc = NULL;
+		for (Py_ssize_t j = 0; desc == NULL && j < PyTuple_Size(mro); ++j)
+		{
+			PyObject *dict = ((PyTypeObject*) PyTuple_GetItem(mro, j))->tp_dict;
+			desc = PyDict_GetItem(dict, name);
+		}
+		if (desc == NULL || !PyObject_TypeCheck(desc, PyJPField_Type))
+		{
+			PyErr_Format(PyExc_AttributeError, "'%s' has no Java field '%U'", type->tp_name, name);
+			JP_RAISE_PYTHON();
+		}
+		JPField *field = ((PyJPField*) desc)->m_Field;
+		if (field->isStatic())
+		{
+			PyErr_Format(PyExc_AttributeError, "Java field '%U' is static", name);
+			JP_RAISE_PYTHON();
+		}
+		fields.push_back(field);
+	}
+}
+
+static PyObject *PyJPField_readRow(JPJavaFrame &frame, vector<JPField*> &fields, jobject inst)
+{
+	JPPyObject row = JPPyObject::call(PyTuple_New(fields.size()));
+	for (size_t i = 0; i < fields.size(); ++i)
+		PyTuple_SetItem(row.get(), i, fields[i]->getPlainField(frame, inst).keep());
+	return row.keep();
+}
+
+PyObject *PyJPField_readFields(PyObject *module, PyObject *args)
+{
+	JP_PY_TRY("PyJPField_readFields");
+	PyObject *target;
+	PyObject *names;
+	if (!PyArg_ParseTuple(args, "OO!", &target, &PyTuple_Type, &names))
+		return NULL;
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	vector<JPField*> fields;
+
+	// A single object gives a single row
+	JPValue *jval = PyJPValue_getJavaSlot(target);
+	if (jval != NULL)
+	{
+		if (jval->getClass()->isPrimitive() || jval->getValue().l == NULL)
+			JP_RAISE(PyExc_TypeError, "fields require a Java object");
+		PyJPField_resolve(Py_TYPE(target), names, fields);
+		return PyJPField_readRow(frame, fields, jval->getValue().l);
+	}
+
+	JPPyObject seq = JPPyObject::call(PySequence_Fast(target, "a Java object or a sequence of Java objects is required"));
+	Py_ssize_t n = PySequence_Fast_GET_SIZE(seq.get());
+	PyObject **items = PySequence_Fast_ITEMS(seq.get());
+	JPPyObject out = JPPyObject::call(PyList_New(n));
+	PyTypeObject *last = NULL;
+	bool objects = false;
+	for (Py_ssize_t i = 0; i < n; ++i)
+	{
+		jval = PyJPValue_getJavaSlot(items[i]);
+		if (jval == NULL || jval->getClass()->isPrimitive() || jval->getValue().l == NULL)
+			JP_RAISE(PyExc_TypeError, "fields require a Java object");
+
+		// Rows of one type share the resolved fields
+		if (Py_TYPE(items[i]) != last)
+		{
+			last = Py_TYPE(items[i]);
+			PyJPField_resolve(last, names, fields);
+			objects = false;
+			for (size_t j = 0; j < fields.size(); ++j)
+				objects |= fields[j]->getTypeCode() == 0;
+		}
+
+		// Object fields create local references so release them each row
+		if (objects)
+		{
+			JPJavaFrame inner = JPJavaFrame::inner(context);
+			PyList_SET_ITEM(out.get(), i, PyJPField_readRow(inner, fields, jval->getValue().l));
+		} else
+			PyList_SET_ITEM(out.get(), i, PyJPField_readRow(frame, fields, jval->getValue().l));
+	}
+	return out.keep();
+	JP_PY_CATCH(NULL);
+}
+
 static PyGetSetDef fieldGetSets[] = {
 	{0}
 };
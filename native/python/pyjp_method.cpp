@@ -13,6 +13,7 @@
 
    See NOTICE file for details.
  *****************************************************************************/
+#include <algorithm>
 #include "jpype.h"
 #include "pyjp.h"
 #include "jp_methoddispatch.h"
@@ -342,12 +343,119 @@ PyObject *PyJPMethod_matchReport(PyJPMethod *self, PyObject *args)
 	JP_PY_CATCH(NULL);
 }
 
+PyObject *PyJPMethod_stats(PyJPMethod *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPMethod_stats");
+	PyJPModule_getContext();
+	JPPyObject out = JPPyObject::call(PyDict_New());
+	JPPyObject calls = JPPyObject::call(PyLong_FromLongLong(self->m_Method->getCallCount()));
+	JPPyObject misses = JPPyObject::call(PyLong_FromLongLong(self->m_Method->getMissCount()));
+	long shortCount = 0;
+	const JPMethodList& overloads = self->m_Method->getMethodOverloads();
+	for (JPMethodList::const_iterator iter = overloads.begin(); iter != overloads.end(); ++iter)
+		shortCount += (*iter)->isGILShort();
+	JPPyObject gilShort = JPPyObject::call(PyLong_FromLong(shortCount));
+	PyDict_SetItemString(out.get(), "calls", calls.get());
+	PyDict_SetItemString(out.get(), "overload_misses", misses.get());
+	PyDict_SetItemString(out.get(), "gil_short", gilShort.get());
+	return out.keep();
+	JP_PY_CATCH(NULL);
+}
+
+PyObject *PyJPMethod_bind(PyJPMethod *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPMethod_bind");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPClassList types;
+	Py_ssize_t n = PyTuple_Size(args);
+	for (Py_ssize_t i = 0; i < n; ++i)
+	{
+		JPClass *cls = PyJPClass_getJPClass(PyTuple_GetItem(args, i));
+		if (cls == NULL)
+			JP_RAISE(PyExc_TypeError, "bind requires Java types");
+		types.push_back(cls);
+	}
+
+	// Find the overload with exactly these parameter types
+	const JPMethodList& overloads = self->m_Method->getMethodOverloads();
+	for (JPMethodList::const_iterator iter = overloads.begin(); iter != overloads.end(); ++iter)
+	{
+		JPMethod *overload = *iter;
+		const JPClassList& params = overload->getParameterTypes();
+		size_t skip = overload->isInstance() ? 1 : 0;
+		if (params.size() - skip != types.size())
+			continue;
+		if (std::equal(types.begin(), types.end(), params.begin() + skip))
+			return PyJPOverload_create(self->m_Method, overload, self->m_Instance).keep();
+	}
+
+	std::stringstream ss;
+	ss << "No overload of " << self->m_Method->getClass()->getCanonicalName()
+			<< "." << self->m_Method->getName() << " with signature (";
+	for (size_t i = 0; i < types.size(); ++i)
+	{
+		if (i != 0)
+			ss << ",";
+		ss << types[i]->getCanonicalName();
+	}
+	ss << ")";
+	JP_RAISE(PyExc_TypeError, ss.str());
+	JP_PY_CATCH(NULL);
+}
+
+static const char* jp_gil_policies[] = {"default", "release", "hold"};
+
+PyObject *PyJPMethod_getGILPolicy(PyJPMethod *self, void *ctxt)
+{
+	JP_PY_TRY("PyJPMethod_getGILPolicy");
+	PyJPModule_getContext();
+	const JPMethodList& overloads = self->m_Method->getMethodOverloads();
+	int policy = JPMethod::_gilDefault;
+	if (!overloads.empty())
+		policy = overloads[0]->getGILPolicy();
+	return PyUnicode_FromString(jp_gil_policies[policy]);
+	JP_PY_CATCH(NULL);
+}
+
+int PyJPMethod_setGILPolicy(PyJPMethod *self, PyObject *obj, void *ctxt)
+{
+	JP_PY_TRY("PyJPMethod_setGILPolicy");
+	PyJPModule_getContext();
+	if (obj == NULL || !PyUnicode_Check(obj))
+	{
+		PyErr_SetString(PyExc_TypeError, "GIL policy must be a string");
+		return -1;
+	}
+	string name = JPPyString::asStringUTF8(obj);
+	int policy = -1;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (name == jp_gil_policies[i])
+			policy = i;
+	}
+	if (policy < 0)
+	{
+		PyErr_Format(PyExc_ValueError, "unknown GIL policy '%s'", name.c_str());
+		return -1;
+	}
+
+	// The policy applies to every overload of the dispatch
+	const JPMethodList& overloads = self->m_Method->getMethodOverloads();
+	for (JPMethodList::const_iterator iter = overloads.begin(); iter != overloads.end(); ++iter)
+		(*iter)->setGILPolicy(policy);
+	return 0;
+	JP_PY_CATCH(-1); // GCOVR_EXCL_LINE
+}
+
 static PyMethodDef methodMethods[] = {
 	{"_isBeanAccessor", (PyCFunction) (&PyJPMethod_isBeanAccessor), METH_NOARGS, ""},
 	{"_isBeanMutator", (PyCFunction) (&PyJPMethod_isBeanMutator), METH_NOARGS, ""},
 	{"matchReport", (PyCFunction) (&PyJPMethod_matchReport), METH_VARARGS, ""},
 	// This is  currently private but may be promoted
 	{"_matches", (PyCFunction) (&PyJPMethod_matches), METH_VARARGS, ""},
+	{"_stats", (PyCFunction) (&PyJPMethod_stats), METH_NOARGS, ""},
+	{"bind", (PyCFunction) (&PyJPMethod_bind), METH_VARARGS, ""},
 	{NULL},
 };
 
@@ -362,6 +470,7 @@ struct PyGetSetDef methodGetSet[] = {
 	{"__kwdefaults__", (getter) (&PyJPMethod_getNone), NULL, NULL, NULL},
 	{"__globals__", (getter) (&PyJPMethod_getGlobals), NULL, NULL, NULL},
 	{"__qualname__", (getter) (&PyJPMethod_getQualName), NULL, NULL, NULL},
+	{"_gilPolicy", (getter) (&PyJPMethod_getGILPolicy), (setter) (&PyJPMethod_setGILPolicy), NULL, NULL},
 	{NULL},
 };
 
@@ -387,6 +496,158 @@ static PyType_Spec methodSpec = {
 	methodSlots
 };
 
+/**
+ * A single overload of a method with its parameter types fixed.
+ *
+ * Calls skip overload resolution and go straight to argument conversion.
+ */
+struct PyJPOverload
+{
+	PyObject_HEAD
+	JPMethodDispatch* m_Method;
+	JPMethod* m_Overload;
+	PyObject* m_Instance;
+} ;
+
+static int PyJPOverload_traverse(PyJPOverload *self, visitproc visit, void *arg)
+{
+	Py_VISIT(self->m_Instance);
+	return 0;
+}
+
+static int PyJPOverload_clear(PyJPOverload *self)
+{
+	Py_CLEAR(self->m_Instance);
+	return 0;
+}
+
+static void PyJPOverload_dealloc(PyJPOverload *self)
+{
+	JP_PY_TRY("PyJPOverload_dealloc");
+	PyObject_GC_UnTrack(self);
+	PyJPOverload_clear(self);
+	Py_TYPE(self)->tp_free(self);
+	JP_PY_CATCH_NONE(); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPOverload_call(PyJPOverload *self, PyObject *args, PyObject *kwargs)
+{
+	JP_PY_TRY("PyJPOverload_call");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	// Clear any pending interrupts if we are on the main thread
+	if (hasInterrupt())
+		frame.clearInterrupt(false);
+	if (self->m_Instance == NULL)
+	{
+		JPPyObjectVector vargs(args);
+		return self->m_Overload->invokeBound(frame, vargs, false).keep();
+	} else
+	{
+		JPPyObjectVector vargs(self->m_Instance, args);
+		return self->m_Overload->invokeBound(frame, vargs, true).keep();
+	}
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPOverload_vectorize(PyJPOverload *self, PyObject *args, PyObject *kwargs)
+{
+	JP_PY_TRY("PyJPOverload_vectorize");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	int parallel = 0;
+	if (kwargs != NULL)
+	{
+		PyObject *value = PyDict_GetItemString(kwargs, "parallel");
+		if (value != NULL)
+		{
+			parallel = PyObject_IsTrue(value);
+			if (parallel < 0)
+				return NULL;
+		}
+		if (PyDict_Size(kwargs) != (value != NULL ? 1 : 0))
+		{
+			PyErr_SetString(PyExc_TypeError, "vectorize only accepts the keyword 'parallel'");
+			return NULL;
+		}
+	}
+	JPPyObjectVector vargs(args);
+	return self->m_Overload->invokeVectorized(frame, vargs, parallel != 0).keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyMethodDef overloadMethods[] = {
+	{"vectorize", (PyCFunction) (&PyJPOverload_vectorize), METH_VARARGS | METH_KEYWORDS, ""},
+	{NULL},
+};
+
+static PyObject *PyJPOverload_repr(PyJPOverload *self)
+{
+	JP_PY_TRY("PyJPOverload_repr");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	std::stringstream ss;
+	const JPClassList& params = self->m_Overload->getParameterTypes();
+	size_t skip = self->m_Overload->isInstance() ? 1 : 0;
+	for (size_t i = skip; i < params.size(); ++i)
+	{
+		if (i != skip)
+			ss << ",";
+		ss << params[i]->getCanonicalName();
+	}
+	return PyUnicode_FromFormat("<java %soverload '%s(%s)' of '%s'>",
+			(self->m_Instance != NULL) ? "bound " : "",
+			self->m_Method->getName().c_str(),
+			ss.str().c_str(),
+			self->m_Method->getClass()->getCanonicalName().c_str());
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPOverload_getSelf(PyJPOverload *self, void *ctxt)
+{
+	JP_PY_TRY("PyJPOverload_getSelf");
+	PyJPModule_getContext();
+	if (self->m_Instance == NULL)
+		Py_RETURN_NONE;
+	Py_INCREF(self->m_Instance);
+	return self->m_Instance;
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPOverload_getName(PyJPOverload *self, void *ctxt)
+{
+	JP_PY_TRY("PyJPOverload_getName");
+	PyJPModule_getContext();
+	return JPPyString::fromStringUTF8(self->m_Method->getName()).keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+struct PyGetSetDef overloadGetSet[] = {
+	{"__self__", (getter) (&PyJPOverload_getSelf), NULL, NULL, NULL},
+	{"__name__", (getter) (&PyJPOverload_getName), NULL, NULL, NULL},
+	{NULL},
+};
+
+static PyType_Slot overloadSlots[] = {
+	{Py_tp_dealloc,   (void*) PyJPOverload_dealloc},
+	{Py_tp_traverse,  (void*) PyJPOverload_traverse},
+	{Py_tp_clear,     (void*) PyJPOverload_clear},
+	{Py_tp_repr,      (void*) PyJPOverload_repr},
+	{Py_tp_call,      (void*) PyJPOverload_call},
+	{Py_tp_methods,   (void*) overloadMethods},
+	{Py_tp_getset,    (void*) overloadGetSet},
+	{0}
+};
+
+PyTypeObject *PyJPOverload_Type = NULL;
+static PyType_Spec overloadSpec = {
+	"_jpype._JOverload",
+	sizeof (PyJPOverload),
+	0,
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+	overloadSlots
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -405,6 +666,11 @@ void PyJPMethod_initType(PyObject* module)
 
 	PyModule_AddObject(module, "_JMethod", (PyObject*) PyJPMethod_Type);
 	JP_PY_CHECK();
+
+	PyJPOverload_Type = (PyTypeObject*) PyType_FromSpec(&overloadSpec);
+	JP_PY_CHECK();
+	PyModule_AddObject(module, "_JOverload", (PyObject*) PyJPOverload_Type);
+	JP_PY_CHECK();
 }
 
 JPPyObject PyJPMethod_create(JPMethodDispatch *m, PyObject *instance)
@@ -421,3 +687,16 @@ JPPyObject PyJPMethod_create(JPMethodDispatch *m, PyObject *instance)
 	return JPPyObject::claim((PyObject*) self);
 	JP_TRACE_OUT; /// GCOVR_EXCL_LINE
 }
+
+JPPyObject PyJPOverload_create(JPMethodDispatch *m, JPMethod *overload, PyObject *instance)
+{
+	JP_TRACE_IN("PyJPOverload_create");
+	PyJPOverload* self = (PyJPOverload*) PyJPOverload_Type->tp_alloc(PyJPOverload_Type, 0);
+	JP_PY_CHECK();
+	self->m_Method = m;
+	self->m_Overload = overload;
+	self->m_Instance = instance;
+	Py_XINCREF(self->m_Instance);
+	return JPPyObject::claim((PyObject*) self);
+	JP_TRACE_OUT; /// GCOVR_EXCL_LINE
+}
@@ -20,11 +20,14 @@
 #include "jp_gc.h"
 #include "jp_stringtype.h"
 #include "jp_classloader.h"
+#include "jp_collections.h"
+#include "jp_datatypes.h"
 
 void PyJPModule_installGC(PyObject* module);
 
 bool _jp_cpp_exceptions = false;
 
+extern void PyJPArena_initType(PyObject* module);
 extern void PyJPArray_initType(PyObject* module);
 extern void PyJPBuffer_initType(PyObject* module);
 extern void PyJPClass_initType(PyObject* module);
@@ -325,6 +328,34 @@ static PyObject* PyJPModule_detachThread(PyObject* obj)
 }
 #endif
 
+static PyObject* PyJPModule_setThreadPolicy(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_setThreadPolicy");
+	int autoDetach;
+	int reuse = 0;
+	if (!PyArg_ParseTuple(args, "p|p", &autoDetach, &reuse))
+		return NULL;
+	JPContext *context = JPContext_global;
+	JPPyObject old = JPPyObject::call(Py_BuildValue("OO",
+			context->getAutoDetach() ? Py_True : Py_False,
+			context->getReuseThreads() ? Py_True : Py_False));
+	context->setThreadPolicy(autoDetach != 0, reuse != 0);
+	return old.keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject* PyJPModule_threadStats(PyObject* module)
+{
+	JP_PY_TRY("PyJPModule_threadStats");
+	long long counts[3];
+	JPContext_global->getThreadCounts(counts);
+	return Py_BuildValue("{sLsLsL}",
+			"attached", counts[0],
+			"attaches", counts[1],
+			"detaches", counts[2]);
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
 static PyObject* PyJPModule_isThreadAttached(PyObject* obj)
 {
 	JP_PY_TRY("PyJPModule_isThreadAttached");
@@ -371,6 +402,87 @@ static PyObject* PyJPModule_convertToDirectByteBuffer(PyObject* self, PyObject*
 	JP_PY_CATCH(NULL);
 }
 
+static PyObject* PyJPModule_collectionToJava(PyObject* self, PyObject* src)
+{
+	JP_PY_TRY("PyJPModule_collectionToJava");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jvalue v;
+	v.l = JPCollections::toJava(frame, src);
+	JPClass *type = frame.findClassForObject(v.l);
+	return type->convertToPythonObject(frame, v, false).keep();
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject* PyJPModule_collectionToPython(PyObject* self, PyObject* src)
+{
+	JP_PY_TRY("PyJPModule_collectionToPython");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPValue *value = PyJPValue_getJavaSlot(src);
+	if (value == NULL || value->getClass()->isPrimitive())
+	{
+		PyErr_SetString(PyExc_TypeError, "Java object is required");
+		return NULL;
+	}
+	return JPCollections::toPython(frame, value->getValue().l).keep();
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject* PyJPModule_unboxNumbers(PyObject* self, PyObject* args)
+{
+	JP_PY_TRY("PyJPModule_unboxNumbers");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	PyObject *src;
+	int code;
+	int mask;
+	if (!PyArg_ParseTuple(args, "OCp", &src, &code, &mask))
+		return NULL;
+	JPValue *value = PyJPValue_getJavaSlot(src);
+	if (value == NULL || value->getClass()->isPrimitive())
+	{
+		PyErr_SetString(PyExc_TypeError, "Java object is required");
+		return NULL;
+	}
+	if (code != 0 && code != 'J' && code != 'D')
+	{
+		PyErr_SetString(PyExc_ValueError, "unbox type must be 'J' or 'D'");
+		return NULL;
+	}
+	return JPCollections::unbox(frame, value->getValue().l, (char) code, mask != 0).keep();
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject* PyJPModule_dataToPython(PyObject* self, PyObject* src)
+{
+	JP_PY_TRY("PyJPModule_dataToPython");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPValue *value = PyJPValue_getJavaSlot(src);
+	if (value == NULL || value->getClass()->isPrimitive())
+	{
+		PyErr_SetString(PyExc_TypeError, "Java object is required");
+		return NULL;
+	}
+	return JPDataTypes::toPython(frame, value->getValue().l).keep();
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject* PyJPModule_dataColumnToPython(PyObject* self, PyObject* src)
+{
+	JP_PY_TRY("PyJPModule_dataColumnToPython");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	if (!PySequence_Check(src))
+	{
+		PyErr_SetString(PyExc_TypeError, "sequence is required");
+		return NULL;
+	}
+	return JPDataTypes::toPythonList(frame, src).keep();
+	JP_PY_CATCH(NULL);
+}
+
 static PyObject* PyJPModule_enableStacktraces(PyObject* self, PyObject* src)
 {
 	_jp_cpp_exceptions = PyObject_IsTrue(src);
@@ -551,6 +663,37 @@ PyObject *PyJPModule_gcStats(PyObject* module, PyObject *obj)
 }
 // GCOVR_EXCL_STOP
 
+static PyObject* PyJPModule_enableStats(PyObject *module, PyObject *arg)
+{
+	int enable = PyObject_IsTrue(arg);
+	if (enable == -1)
+		return NULL;
+	int old = _jp_stats_enabled;
+	_jp_stats_enabled = enable;
+	return PyBool_FromLong(old);
+}
+
+static PyObject* PyJPModule_stats(PyObject *module)
+{
+	JP_PY_TRY("PyJPModule_stats");
+	long long values[JPStat_COUNT];
+	JPStats_get(values);
+	JPPyObject out = JPPyObject::call(PyDict_New());
+	for (int i = 0; i < JPStat_COUNT; ++i)
+	{
+		JPPyObject value = JPPyObject::call(PyLong_FromLongLong(values[i]));
+		PyDict_SetItemString(out.get(), JPStats_getName(i), value.get());
+	}
+	return out.keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject* PyJPModule_resetStats(PyObject *module)
+{
+	JPStats_reset();
+	Py_RETURN_NONE;
+}
+
 static PyObject* PyJPModule_isPackage(PyObject *module, PyObject *pkg)
 {
 	JP_PY_TRY("PyJPModule_isPackage");
@@ -626,6 +769,81 @@ static PyObject* PyJPModule_trace(PyObject *module, PyObject *args)
 }
 // GCOVR_EXCL_STOP
 
+static PyObject* PyJPModule_enableTraceEvents(PyObject *module, PyObject *arg)
+{
+	int enable = PyObject_IsTrue(arg);
+	if (enable == -1)
+		return NULL;
+	int old = _jp_trace_events;
+	_jp_trace_events = enable;
+	return PyBool_FromLong(old);
+}
+
+static PyObject* PyJPModule_dumpTraceEvents(PyObject *module, PyObject *arg)
+{
+	JP_PY_TRY("PyJPModule_dumpTraceEvents");
+	JPPyObject path = JPPyObject::call(PyOS_FSPath(arg));
+	string filename = JPPyString::asStringUTF8(path.get());
+	bool ok;
+	{
+		// Writing may take a while, let other threads run
+		JPPyCallRelease call;
+		ok = JPTraceEvents::dump(filename.c_str());
+	}
+	if (!ok)
+	{
+		PyErr_Format(PyExc_OSError, "Unable to write trace to '%s'", filename.c_str());
+		return NULL;
+	}
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject* PyJPModule_clearTraceEvents(PyObject *module)
+{
+	JPTraceEvents::clear();
+	Py_RETURN_NONE;
+}
+
+static PyObject* PyJPModule_setArrayParallel(PyObject *module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_setArrayParallel");
+	Py_ssize_t threshold;
+	int workers;
+	if (!PyArg_ParseTuple(args, "ni", &threshold, &workers))
+		return NULL;
+	if (threshold < 0 || workers < 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "threshold and workers must not be negative");
+		return NULL;
+	}
+	JPPyObject old = JPPyObject::call(Py_BuildValue("ni",
+			JPParallel::getThreshold(), JPParallel::getWorkers()));
+	JPParallel::setPolicy(threshold, workers);
+	return old.keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject* PyJPModule_setAdaptiveGIL(PyObject *module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_setAdaptiveGIL");
+	int enable;
+	long long threshold = _jp_gil_threshold;
+	if (!PyArg_ParseTuple(args, "p|L", &enable, &threshold))
+		return NULL;
+	if (threshold < 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "threshold must not be negative");
+		return NULL;
+	}
+	// Set the threshold first so that calls never see the new mode with
+	// the old threshold
+	long long oldThreshold = _jp_gil_threshold.exchange(threshold);
+	int oldEnable = _jp_gil_adaptive.exchange(enable);
+	return Py_BuildValue("OL", oldEnable ? Py_True : Py_False, oldThreshold);
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
 #ifdef JP_INSTRUMENTATION
 uint32_t _PyJPModule_fault_code = -1;
 
@@ -673,9 +891,14 @@ static PyMethodDef moduleMethods[] = {
 	{"_newArrayType", (PyCFunction) PyJPModule_newArrayType, METH_VARARGS, ""},
 	{"_collect", (PyCFunction) PyJPModule_collect, METH_VARARGS, ""},
 	{"gcStats", (PyCFunction) PyJPModule_gcStats, METH_NOARGS, ""},
+	{"enableStats", (PyCFunction) PyJPModule_enableStats, METH_O, ""},
+	{"stats", (PyCFunction) PyJPModule_stats, METH_NOARGS, ""},
+	{"resetStats", (PyCFunction) PyJPModule_resetStats, METH_NOARGS, ""},
 
 	// Threading
 	{"isThreadAttachedToJVM", (PyCFunction) PyJPModule_isThreadAttached, METH_NOARGS, ""},
+	{"setThreadPolicy", (PyCFunction) PyJPModule_setThreadPolicy, METH_VARARGS, ""},
+	{"threadStats", (PyCFunction) PyJPModule_threadStats, METH_NOARGS, ""},
 #ifndef ANDROID
 	{"attachThreadToJVM", (PyCFunction) PyJPModule_attachThread, METH_NOARGS, ""},
 	{"detachThreadFromJVM", (PyCFunction) PyJPModule_detachThread, METH_NOARGS, ""},
@@ -685,10 +908,21 @@ static PyMethodDef moduleMethods[] = {
 	//{"dumpJVMStats", (PyCFunction) (&PyJPModule_dumpJVMStats), METH_NOARGS, ""},
 
 	{"convertToDirectBuffer", (PyCFunction) PyJPModule_convertToDirectByteBuffer, METH_O, ""},
+	{"collectionToJava", (PyCFunction) PyJPModule_collectionToJava, METH_O, ""},
+	{"collectionToPython", (PyCFunction) PyJPModule_collectionToPython, METH_O, ""},
+	{"unboxNumbers", (PyCFunction) PyJPModule_unboxNumbers, METH_VARARGS, ""},
+	{"dataToPython", (PyCFunction) PyJPModule_dataToPython, METH_O, ""},
+	{"dataColumnToPython", (PyCFunction) PyJPModule_dataColumnToPython, METH_O, ""},
+	{"readFields", (PyCFunction) PyJPField_readFields, METH_VARARGS, ""},
 	{"arrayFromBuffer", (PyCFunction) PyJPModule_arrayFromBuffer, METH_VARARGS, ""},
 	{"enableStacktraces", (PyCFunction) PyJPModule_enableStacktraces, METH_O, ""},
 	{"isPackage", (PyCFunction) PyJPModule_isPackage, METH_O, ""},
 	{"trace", (PyCFunction) PyJPModule_trace, METH_O, ""},
+	{"enableTraceEvents", (PyCFunction) PyJPModule_enableTraceEvents, METH_O, ""},
+	{"dumpTraceEvents", (PyCFunction) PyJPModule_dumpTraceEvents, METH_O, ""},
+	{"clearTraceEvents", (PyCFunction) PyJPModule_clearTraceEvents, METH_NOARGS, ""},
+	{"setArrayParallel", (PyCFunction) PyJPModule_setArrayParallel, METH_VARARGS, ""},
+	{"setAdaptiveGIL", (PyCFunction) PyJPModule_setAdaptiveGIL, METH_VARARGS, ""},
 #ifdef JP_INSTRUMENTATION
 	{"fault", (PyCFunction) PyJPModule_fault, METH_O, ""},
 #endif
@@ -724,6 +958,11 @@ PyMODINIT_FUNC PyInit__jpype()
 
 	// Initialize the module (depends on python version)
 	PyObject* module = PyModule_Create(&moduledef);
+#ifdef Py_GIL_DISABLED
+	// Shared caches are synchronized so free threaded builds can run
+	// Java calls in parallel.
+	PyUnstable_Module_SetGIL(module, Py_MOD_GIL_NOT_USED);
+#endif
 	// PyJPModule = module;
 	Py_INCREF(module);
 	PyJPModule = module;
@@ -746,6 +985,7 @@ PyMODINIT_FUNC PyInit__jpype()
 	PyJPMethod_initType(module);
 	PyJPNumber_initType(module);
 	PyJPMonitor_initType(module);
+	PyJPArena_initType(module);
 	PyJPProxy_initType(module);
 	PyJPClassHints_initType(module);
 	PyJPPackage_initType(module);
@@ -822,23 +1062,29 @@ static PyObject *PyJPModule_convertBuffer(JPPyBuffer& buffer, PyObject *dtype)
 		}
 	} else
 	{
+		// Unsigned types widen to the next larger signed type so that no
+		// values are lost.  There is nothing larger than long, so unsigned
+		// 64 bit requires an explicit dtype.  Half precision widens to float.
 		switch (format[0])
 		{
 			case '?': cls = context->_boolean;
+				break;
 			case 'c': break;
 			case 'b': cls = context->_byte;
-			case 'B': break;
+				break;
+			case 'B':
 			case 'h': cls = context->_short;
 				break;
-			case 'H': break;
+			case 'H':
 			case 'i':
 			case 'l': cls = context->_int;
 				break;
 			case 'I':
-			case 'L': break;
+			case 'L':
 			case 'q': cls = context->_long;
 				break;
 			case 'Q': break;
+			case 'e':
 			case 'f': cls = context->_float;
 				break;
 			case 'd': cls = context->_double;
@@ -863,17 +1109,8 @@ static PyObject *PyJPModule_convertBuffer(JPPyBuffer& buffer, PyObject *dtype)
 	// Convert the shape
 	Py_ssize_t subs = 1;
 	Py_ssize_t base = 1;
-	jintArray jdims = (jintArray) context->_int->newArrayOf(frame, view.ndim);
 	if (view.shape != NULL)
 	{
-		JPPrimitiveArrayAccessor<jintArray, jint*> accessor(frame, jdims,
-				&JPJavaFrame::GetIntArrayElements, &JPJavaFrame::ReleaseIntArrayElements);
-		jint *a = accessor.get();
-		for (int i = 0; i < view.ndim; ++i)
-		{
-			a[i] = view.shape[i];
-		}
-		accessor.commit();
 		for (int i = 0; i < view.ndim - 1; ++i)
 		{
 			subs *= view.shape[i];
@@ -888,7 +1125,7 @@ static PyObject *PyJPModule_convertBuffer(JPPyBuffer& buffer, PyObject *dtype)
 		}
 		base = view.len / view.itemsize;
 	}
-	return pcls->newMultiArray(frame, buffer, subs, base, (jobject) jdims);
+	return pcls->newMultiArray(frame, buffer, subs, base);
 }
 
 #ifdef JP_INSTRUMENTATION
@@ -122,12 +122,19 @@ static PyObject *PyJPPackage_getattro(PyObject *self, PyObject *attr)
 	if (dict != NULL)
 	{
 		// Check the cache
-		PyObject *out = PyDict_GetItem(PyModule_GetDict(self), attr);
+#if PY_VERSION_HEX>=0x030D0000
+		// Borrowed references from the dict are unsafe without the GIL
+		PyObject *out = NULL;
+		if (PyDict_GetItemRef(dict, attr, &out) != 0)
+			return out;
+#else
+		PyObject *out = PyDict_GetItem(dict, attr);
 		if (out != NULL)
 		{
 			Py_INCREF(out);
 			return out;
 		}
+#endif
 	}
 
 	string attrName = JPPyString::asStringUTF8(attr).c_str();
@@ -193,9 +200,20 @@ static PyObject *PyJPPackage_getattro(PyObject *self, PyObject *attr)
 		PyErr_Format(PyExc_AttributeError, "'%U' is unknown object type in Java package", attr);
 		return NULL;
 	}
-	// Cache the item for now
-	PyDict_SetItem(dict, attr, out.get()); // no steal
-	return out.keep();
+	// Cache the item for now.  If another thread cached it first, use theirs
+	// so that every caller sees the same object.
+#if PY_VERSION_HEX>=0x030D0000
+	PyObject *cached = NULL;
+	if (PyDict_SetDefaultRef(dict, attr, out.get(), &cached) < 0)
+		return NULL;
+	return cached;
+#else
+	PyObject *cached = PyDict_SetDefault(dict, attr, out.get()); // no steal
+	if (cached == NULL)
+		return NULL;
+	Py_INCREF(cached);
+	return cached;
+#endif
 	JP_PY_CATCH(NULL);  // GCOVR_EXCL_LINE
 }
 
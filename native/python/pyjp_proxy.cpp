@@ -86,6 +86,10 @@ static int PyJPProxy_traverse(PyJPProxy *self, visitproc visit, void *arg)
 
 static int PyJPProxy_clear(PyJPProxy *self)
 {
+	// The target address may be reused once it is released
+	JPProxyFunctional *functional = dynamic_cast<JPProxyFunctional*> (self->m_Proxy);
+	if (functional != NULL)
+		functional->removeFromCache();
 	Py_CLEAR(self->m_Target);
 	return 0;
 }
@@ -94,6 +98,7 @@ void PyJPProxy_dealloc(PyJPProxy* self)
 {
 	JP_PY_TRY("PyJPProxy_dealloc");
 	delete self->m_Proxy;
+	self->m_Proxy = NULL;
 	PyObject_GC_UnTrack(self);
 	PyJPProxy_clear(self);
 	Py_TYPE(self)->tp_free(self);
@@ -0,0 +1,512 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+"""Benchmark suite for the cost of crossing between Python and Java.
+
+Usage::
+
+    python test/benchmark/bench.py [-k PATTERN] [-o results.json]
+        [--baseline baseline.json] [--threshold 0.10] [--list]
+
+Each benchmark is timed with an automatically calibrated loop count and
+repeated several times.  The median time per operation in nanoseconds is
+reported.  When a baseline is given, any benchmark that became slower by
+more than the threshold is reported as a regression and the exit status is
+nonzero.  A results file can itself be used as a future baseline.
+
+The Java fixtures are in ``test/harness/jpype/bench`` and must be compiled
+with ``ant -f test/build.xml`` before running.
+"""
+import argparse
+import fnmatch
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import time
+
+import jpype
+
+_benchmarks = []
+_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def benchmark(name, cold=False):
+    """Register a benchmark.
+
+    The decorated function is called once to prepare the benchmark and
+    must return a function of no arguments which performs one operation.
+    It may raise ``NotImplementedError`` to skip the benchmark.
+
+    Cold benchmarks are run once per sample and the operation returns
+    its own elapsed time in nanoseconds.
+    """
+    def register(func):
+        _benchmarks.append((name, func, cold))
+        return func
+    return register
+
+
+def _timeit(op, loops):
+    r = range(loops)
+    start = time.perf_counter_ns()
+    for _ in r:
+        op()
+    return time.perf_counter_ns() - start
+
+
+def _measure(op, repeat, target):
+    # Calibrate the loop count so each sample takes roughly the target time
+    loops = 1
+    while True:
+        elapsed = _timeit(op, loops)
+        if elapsed >= target * 1e9 or loops >= 1 << 24:
+            break
+        loops *= 10 if elapsed < target * 1e8 else 2
+    samples = [_timeit(op, loops) / loops for _ in range(repeat)]
+    return {
+        "ns": statistics.median(samples),
+        "min": min(samples),
+        "max": max(samples),
+        "loops": loops,
+        "repeat": repeat,
+    }
+
+
+def startJVM():
+    jpype.addClassPath(os.path.join(_root, "classes"))
+    jpype.addClassPath(os.path.join(os.path.dirname(_root), "lib", "*"))
+    jpype.startJVM("-Xmx256M", convertStrings=False)
+
+
+# Benchmark definitions
+@benchmark("call.static")
+def _callStatic():
+    return jpype.JClass("jpype.bench.Bench").staticCall
+
+
+@benchmark("call.static_int")
+def _callStaticInt():
+    f = jpype.JClass("jpype.bench.Bench").staticInt
+    return lambda: f(1)
+
+
+@benchmark("call.instance")
+def _callInstance():
+    return jpype.JClass("jpype.bench.Bench")().instanceCall
+
+
+@benchmark("call.instance_int")
+def _callInstanceInt():
+    f = jpype.JClass("jpype.bench.Bench")().instanceInt
+    return lambda: f(1)
+
+
+@benchmark("call.overloaded")
+def _callOverloaded():
+    f = jpype.JClass("jpype.bench.Bench").overloaded
+    return lambda: f(1.0)
+
+
+@benchmark("call.overloaded_mixed")
+def _callOverloadedMixed():
+    f = jpype.JClass("jpype.bench.Bench").overloaded
+    s = jpype.JString("a")
+
+    def op():
+        f(1)
+        f(s)
+        f(1.0)
+    return op
+
+
+@benchmark("call.varargs")
+def _callVarargs():
+    f = jpype.JClass("jpype.bench.Bench").varargs
+    return lambda: f(1, 2, 3)
+
+
+@benchmark("call.constructor")
+def _callConstructor():
+    return jpype.JClass("jpype.bench.Bench")
+
+
+@benchmark("field.get")
+def _fieldGet():
+    obj = jpype.JClass("jpype.bench.Bench")()
+    return lambda: obj.intField
+
+
+@benchmark("field.set")
+def _fieldSet():
+    obj = jpype.JClass("jpype.bench.Bench")()
+
+    def op():
+        obj.intField = 1
+    return op
+
+
+@benchmark("field.static_get")
+def _fieldStaticGet():
+    cls = jpype.JClass("jpype.bench.Bench")
+    return lambda: cls.staticField
+
+
+@benchmark("field.get_batch")
+def _fieldGetBatch():
+    Bench = jpype.JClass("jpype.bench.Bench")
+    objs = [Bench() for _ in range(1000)]
+    return lambda: jpype.getFields(objs, "intField", "objectField")
+
+
+@benchmark("convert.box_int")
+def _convertBoxInt():
+    f = jpype.JClass("jpype.bench.Bench").boxed
+    return lambda: f(1)
+
+
+@benchmark("convert.unbox_int")
+def _convertUnboxInt():
+    i = jpype.JClass("java.lang.Integer").valueOf(12345)
+    return lambda: int(i)
+
+
+@benchmark("convert.box_list")
+def _convertBoxList():
+    ArrayList = jpype.JClass("java.util.ArrayList")
+    data = list(range(-100, 900))
+
+    def op():
+        lst = ArrayList()
+        for i in data:
+            lst.add(i)
+    return op
+
+
+@benchmark("convert.string_roundtrip")
+def _convertString():
+    f = jpype.JClass("jpype.bench.Bench").string
+    s = "hello world" * 4
+    return lambda: str(f(s))
+
+
+@benchmark("array.int_to_python")
+def _arrayIntTo():
+    a = jpype.JClass("jpype.bench.Bench").intArray(10000)
+    return lambda: a[:]
+
+
+@benchmark("array.int_from_python")
+def _arrayIntFrom():
+    JInt = jpype.JArray(jpype.JInt)
+    data = list(range(10000))
+    return lambda: JInt(data)
+
+
+@benchmark("array.double_memoryview")
+def _arrayDoubleView():
+    a = jpype.JClass("jpype.bench.Bench").doubleArray(10000)
+    return lambda: bytes(memoryview(a))
+
+
+def _numpy():
+    try:
+        import numpy
+        return numpy
+    except ImportError:
+        raise NotImplementedError("numpy is not available")
+
+
+@benchmark("array.uint8_of")
+def _arrayUint8Of():
+    np = _numpy()
+    data = np.arange(1000000, dtype=np.uint8)
+    return lambda: jpype.JArray.of(data)
+
+
+@benchmark("array.float16_of")
+def _arrayFloat16Of():
+    np = _numpy()
+    data = np.random.random(1000000).astype(np.float16)
+    return lambda: jpype.JArray.of(data)
+
+
+@benchmark("array.uint16_assign")
+def _arrayUint16Assign():
+    np = _numpy()
+    data = np.arange(1000000, dtype=np.uint16)
+    a = jpype.JArray(jpype.JInt)(len(data))
+    def op():
+        a[:] = data
+    return op
+
+
+@benchmark("array.object_to_python")
+def _arrayObjectTo():
+    a = jpype.JClass("jpype.bench.Bench").stringArray(1000)
+    return lambda: list(a)
+
+
+@benchmark("proxy.callback")
+def _proxyCallback():
+    f = jpype.JClass("jpype.bench.Bench").callback
+
+    @jpype.JImplements("java.util.function.IntUnaryOperator")
+    class Op(object):
+        @jpype.JOverride
+        def applyAsInt(self, i):
+            return i
+    op = Op()
+    return lambda: f(op, 100)
+
+
+@benchmark("exception.throw_catch")
+def _exceptionThrow():
+    f = jpype.JClass("jpype.bench.Bench").fail
+    ex = jpype.JClass("java.lang.IllegalStateException")
+
+    def op():
+        try:
+            f()
+        except ex:
+            pass
+    return op
+
+
+@benchmark("iterate.list")
+def _iterateList():
+    lst = jpype.JClass("jpype.bench.Bench").list(1000)
+    return lambda: [i for i in lst]
+
+
+@benchmark("iterate.list_unbox")
+def _iterateListUnbox():
+    lst = jpype.JClass("jpype.bench.Bench").list(1000)
+    return lambda: jpype.unbox(lst)
+
+
+@benchmark("dbapi2.fetchall")
+def _dbapiFetch():
+    import jpype.dbapi2 as dbapi2
+    try:
+        cx = dbapi2.connect("jdbc:sqlite::memory:")
+    except Exception:
+        raise NotImplementedError("sqlite driver not available")
+    cur = cx.cursor()
+    cur.execute("create table bench(i integer, d double, s varchar(20))")
+    cur.executemany("insert into bench values(?,?,?)",
+                    [(i, i * 0.5, str(i)) for i in range(1000)])
+
+    def op():
+        cur.execute("select * from bench")
+        cur.fetchall()
+    return op
+
+
+def _pickleData():
+    # A serializable Java object holding about 4 MB
+    return jpype.JArray(jpype.JInt)(list(range(1 << 20)))
+
+
+@benchmark("pickle.dump")
+def _pickleDump():
+    from jpype.pickle import JPickler
+    import io
+    data = _pickleData()
+    return lambda: JPickler(io.BytesIO(), 4).dump(data)
+
+
+@benchmark("pickle.dump_outofband")
+def _pickleDumpOutOfBand():
+    from jpype.pickle import JPickler
+    import io
+    if sys.version_info < (3, 8):
+        raise NotImplementedError("protocol 5 not available")
+    data = _pickleData()
+    return lambda: JPickler(io.BytesIO(), 5, buffer_callback=list().append).dump(data)
+
+
+@benchmark("pickle.load")
+def _pickleLoad():
+    from jpype.pickle import JPickler, JUnpickler
+    import io
+    fd = io.BytesIO()
+    JPickler(fd, 4).dump(_pickleData())
+    payload = fd.getvalue()
+    return lambda: JUnpickler(io.BytesIO(payload)).load()
+
+
+@benchmark("pickle.load_outofband")
+def _pickleLoadOutOfBand():
+    from jpype.pickle import JPickler, JUnpickler
+    import io
+    if sys.version_info < (3, 8):
+        raise NotImplementedError("protocol 5 not available")
+    fd = io.BytesIO()
+    buffers = []
+    JPickler(fd, 5, buffer_callback=buffers.append).dump(_pickleData())
+    payload = fd.getvalue()
+    return lambda: JUnpickler(io.BytesIO(payload), buffers=buffers).load()
+
+
+def _threadedCalls(threads, calls=8000):
+    # A fixed amount of work split over a pool so that the time per
+    # operation falls as threads are added when calls run in parallel.
+    from concurrent.futures import ThreadPoolExecutor
+    f = jpype.JClass("jpype.bench.Bench").overloaded
+    pool = ThreadPoolExecutor(threads)
+    per = range(calls // threads)
+
+    def work():
+        for _ in per:
+            f(1.0)
+
+    def op():
+        for future in [pool.submit(work) for _ in range(threads)]:
+            future.result()
+    return op
+
+
+for _threads in (1, 2, 4, 8):
+    benchmark("threads.overloaded_x%d" % _threads)(
+        lambda n=_threads: _threadedCalls(n))
+
+
+_import_script = """
+import time, jpype, jpype.imports
+jpype.startJVM()
+start = time.perf_counter_ns()
+import java.util.concurrent
+import java.util.concurrent.atomic
+import java.nio.file
+from java.util.concurrent import ConcurrentHashMap, ThreadPoolExecutor
+from java.nio.file import Files, Paths
+print(time.perf_counter_ns() - start)
+"""
+
+
+@benchmark("import.classes", cold=True)
+def _importClasses():
+    # Import time only shows on a fresh JVM so each sample is a new process
+    def op():
+        out = subprocess.check_output([sys.executable, "-c", _import_script])
+        return int(out.split()[-1])
+    return op
+
+
+def run(pattern="*", repeat=5, target=0.2):
+    results = {}
+    for name, setup, cold in _benchmarks:
+        if not fnmatch.fnmatch(name, pattern):
+            continue
+        try:
+            op = setup()
+        except NotImplementedError as ex:
+            print("%-28s skipped (%s)" % (name, ex))
+            continue
+        if cold:
+            samples = [op() for _ in range(repeat)]
+            result = {"ns": statistics.median(samples), "min": min(samples),
+                      "max": max(samples), "loops": 1, "repeat": repeat}
+        else:
+            result = _measure(op, repeat, target)
+        results[name] = result
+        print("%-28s %12.1f ns" % (name, result["ns"]))
+    return results
+
+
+def metadata():
+    System = jpype.JClass("java.lang.System")
+    return {
+        "jpype": jpype.__version__,
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "java": str(System.getProperty("java.version")),
+        "vm": str(System.getProperty("java.vm.name")),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "time": time.strftime("%Y-%m-%dT%H:%M:%S"),
+    }
+
+
+def compare(results, baseline, threshold):
+    """Compare results against a baseline.
+
+    Returns a list of (name, baseline_ns, current_ns, ratio) for every
+    benchmark that regressed by more than the threshold.
+    """
+    regressions = []
+    print()
+    print("%-28s %12s %12s %8s" % ("benchmark", "baseline", "current", "ratio"))
+    for name, current in sorted(results.items()):
+        if name not in baseline:
+            continue
+        base = baseline[name]["ns"]
+        ratio = current["ns"] / base if base else float("inf")
+        flag = ""
+        if ratio > 1.0 + threshold:
+            flag = "  REGRESSION"
+            regressions.append((name, base, current["ns"], ratio))
+        elif ratio < 1.0 - threshold:
+            flag = "  improved"
+        print("%-28s %12.1f %12.1f %8.2f%s" %
+              (name, base, current["ns"], ratio, flag))
+    return regressions
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="JPype benchmark suite")
+    parser.add_argument("-k", dest="pattern", default="*",
+                        help="run only benchmarks matching a glob pattern")
+    parser.add_argument("-o", "--output", help="write results as JSON")
+    parser.add_argument("--baseline", help="compare against a results file")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="fractional slowdown reported as a regression")
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--time", type=float, default=0.2,
+                        help="target seconds for each sample")
+    parser.add_argument("--list", action="store_true",
+                        help="list the benchmarks and exit")
+    args = parser.parse_args(argv)
+
+    if args.list:
+        for name, _, _ in _benchmarks:
+            print(name)
+        return 0
+
+    startJVM()
+    results = run(args.pattern, args.repeat, args.time)
+    report = {"metadata": metadata(), "benchmarks": results}
+    if args.output:
+        with open(args.output, "w") as fd:
+            json.dump(report, fd, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline) as fd:
+            baseline = json.load(fd)["benchmarks"]
+        regressions = compare(results, baseline, args.threshold)
+        if regressions:
+            print("\n%d benchmark(s) regressed by more than %d%%" %
+                  (len(regressions), args.threshold * 100))
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,131 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package jpype.bench;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.function.IntUnaryOperator;
+
+/**
+ * Fixture for the benchmark suite in test/benchmark.
+ *
+ * The methods are kept trivial so that the measurements are dominated by the
+ * cost of crossing between Python and Java.
+ */
+public class Bench
+{
+
+  public static int staticField = 0;
+  public int intField = 0;
+  public Object objectField = null;
+
+  public static void staticCall()
+  {
+  }
+
+  public void instanceCall()
+  {
+  }
+
+  public static int staticInt(int i)
+  {
+    return i;
+  }
+
+  public int instanceInt(int i)
+  {
+    return i;
+  }
+
+  public static Object overloaded(Object o)
+  {
+    return o;
+  }
+
+  public static String overloaded(String s)
+  {
+    return s;
+  }
+
+  public static long overloaded(long l)
+  {
+    return l;
+  }
+
+  public static double overloaded(double d)
+  {
+    return d;
+  }
+
+  public static int overloaded(int[] a)
+  {
+    return a.length;
+  }
+
+  public static int varargs(Object... args)
+  {
+    return args.length;
+  }
+
+  public static Integer boxed(Integer i)
+  {
+    return i;
+  }
+
+  public static String string(String s)
+  {
+    return s;
+  }
+
+  public static int[] intArray(int n)
+  {
+    return new int[n];
+  }
+
+  public static double[] doubleArray(int n)
+  {
+    return new double[n];
+  }
+
+  public static String[] stringArray(int n)
+  {
+    String[] out = new String[n];
+    for (int i = 0; i < n; ++i)
+      out[i] = Integer.toString(i);
+    return out;
+  }
+
+  public static List<Integer> list(int n)
+  {
+    List<Integer> out = new ArrayList<>(n);
+    for (int i = 0; i < n; ++i)
+      out.add(i);
+    return out;
+  }
+
+  public static int callback(IntUnaryOperator op, int n)
+  {
+    int total = 0;
+    for (int i = 0; i < n; ++i)
+      total += op.applyAsInt(i);
+    return total;
+  }
+
+  public static void fail()
+  {
+    throw new IllegalStateException("bench");
+  }
+}
@@ -0,0 +1,155 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import jpype
+import jpype.nio
+from jpype.types import *
+import common
+
+
+class ArenaTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.arena = jpype.nio.Arena(1 << 16)
+
+    def tearDown(self):
+        self.arena.close()
+
+    def testSize(self):
+        self.assertGreaterEqual(self.arena.size, 1 << 16)
+        self.assertEqual(self.arena.used, 0)
+
+    def testBadSize(self):
+        with self.assertRaises(ValueError):
+            jpype.nio.Arena(0)
+
+    def testAllocate(self):
+        jb = self.arena.allocate(100)
+        self.assertIsInstance(jb, JClass("java.nio.ByteBuffer"))
+        self.assertTrue(jb.isDirect())
+        self.assertEqual(jb.capacity(), 100)
+        self.assertGreaterEqual(self.arena.used, 100)
+
+    def testShared(self):
+        jb = self.arena.allocate(16)
+        mv = memoryview(jb)
+        self.assertEqual(len(mv), 16)
+        mv[0:5] = b"hello"
+        self.assertEqual(jb.get(0), ord("h"))
+        jb.put(1, 0x41)
+        self.assertEqual(mv[1], 0x41)
+
+    def testDisjoint(self):
+        a = self.arena.allocate(10)
+        b = self.arena.allocate(10)
+        memoryview(a)[:] = b"a" * 10
+        memoryview(b)[:] = b"b" * 10
+        self.assertEqual(bytes(memoryview(a)), b"a" * 10)
+        self.assertEqual(bytes(memoryview(b)), b"b" * 10)
+
+    def testRelease(self):
+        jb = self.arena.allocate(1000)
+        self.arena.release(jb)
+        self.assertEqual(self.arena.used, 0)
+        with self.assertRaises(ValueError):
+            self.arena.release(jb)
+
+    def testReleaseForeign(self):
+        jb = JClass("java.nio.ByteBuffer").allocateDirect(10)
+        with self.assertRaises(ValueError):
+            self.arena.release(jb)
+        with self.assertRaises(TypeError):
+            self.arena.release(object())
+
+    def testReuse(self):
+        # Blocks are coalesced so the whole arena can be reused
+        size = self.arena.size
+        blocks = [self.arena.allocate(size // 4) for i in range(4)]
+        with self.assertRaises(MemoryError):
+            self.arena.allocate(1)
+        for jb in blocks[1::2] + blocks[0::2]:
+            self.arena.release(jb)
+        self.assertEqual(self.arena.used, 0)
+        self.arena.allocate(size)
+
+    def testExhausted(self):
+        with self.assertRaises(MemoryError):
+            self.arena.allocate(self.arena.size + 1)
+
+    def testEpoch(self):
+        self.assertEqual(self.arena.epoch, 0)
+        self.arena.allocate(10)
+        self.arena.allocate(10)
+        e1 = self.arena.advance()
+        self.assertEqual(e1, 1)
+        b = self.arena.allocate(10)
+        self.arena.advance()
+        self.assertEqual(self.arena.reclaim(0), 2)
+        self.assertGreater(self.arena.used, 0)
+        self.assertEqual(self.arena.reclaim(e1), 1)
+        self.assertEqual(self.arena.used, 0)
+        with self.assertRaises(ValueError):
+            self.arena.release(b)
+
+    def testClose(self):
+        jb = self.arena.allocate(10)
+        self.arena.close()
+        self.assertTrue(self.arena.closed)
+        with self.assertRaises(ValueError):
+            self.arena.allocate(10)
+        # Memory stays valid while Java holds the block
+        memoryview(jb)[0] = 1
+        self.assertEqual(jb.get(0), 1)
+
+    def testCloseCollected(self):
+        arena = jpype.nio.Arena(4096)
+        arena.close()
+        # Once Java collects the buffer the arena itself is freed
+        jpype.java.lang.System.gc()
+        jpype.java.lang.System.gc()
+        self.assertTrue(arena.closed)
+        self.assertIn("closed", repr(arena))
+        arena.close()
+        with self.assertRaises(ValueError):
+            arena.size
+
+    def testReinit(self):
+        arena = jpype.nio.Arena(4096)
+        arena.allocate(10)
+        arena.__init__(8192)
+        self.assertEqual(arena.size, 8192)
+        self.assertEqual(arena.used, 0)
+        arena.close()
+
+    def testContext(self):
+        with jpype.nio.Arena(4096) as arena:
+            arena.allocate(10)
+        self.assertTrue(arena.closed)
+
+    def testHugePages(self):
+        arena = jpype.nio.Arena(1 << 16, hugepages=True)
+        jb = arena.allocate(10)
+        memoryview(jb)[0] = 1
+        arena.close()
+
+    def testJava(self):
+        jb = self.arena.allocate(8)
+        jb.putLong(0, 12345)
+        self.assertEqual(jb.getLong(0), 12345)
+        with self.assertRaises(JException):
+            jb.putLong(1, 12345)
@@ -488,15 +488,60 @@ class ArrayTestCase(common.JPypeTestCase):
     def testArrayOfDoubleCast(self):
         self.checkArrayOfCast(JDouble, np.float64)
 
+    @common.requireNumpy
+    def testArrayOfUnsigned(self):
+        self.checkArrayOf(JShort, np.uint8, 0, 2**8 - 1)
+        self.checkArrayOf(JInt, np.uint16, 0, 2**16 - 1)
+        self.checkArrayOf(JLong, np.uint32, 0, 2**32 - 1)
+
+    @common.requireNumpy
+    def testArrayOfUnsignedLimits(self):
+        a = np.array([0, 1, 127, 128, 255], dtype=np.uint8)
+        self.assertEqual(list(JArray.of(a)), [0, 1, 127, 128, 255])
+        a = np.array([0, 32767, 32768, 65535], dtype=np.uint16)
+        self.assertEqual(list(JArray.of(a)), [0, 32767, 32768, 65535])
+        a = np.array([0, 2**31 - 1, 2**31, 2**32 - 1], dtype=np.uint32)
+        self.assertEqual(list(JArray.of(a)), [0, 2**31 - 1, 2**31, 2**32 - 1])
+        # Unsigned 64 bit has no wider Java type so it must be requested
+        a = np.array([0, 2**63 - 1], dtype=np.uint64)
+        self.assertEqual(list(JArray.of(a, dtype=JLong)), [0, 2**63 - 1])
+
+    @common.requireNumpy
+    def testArrayOfHalf(self):
+        self.checkArrayOf(JFloat, np.float16)
+
+    @common.requireNumpy
+    def testArrayOfHalfSpecial(self):
+        a = np.array([0.0, -0.0, 1.0, -2.5, 65504.0, 6e-8, 6.1e-5,
+                      np.inf, -np.inf, np.nan], dtype=np.float16)
+        ja = JArray.of(a)
+        self.assertIsInstance(ja, JArray(JFloat))
+        b = np.array(ja)
+        self.assertTrue(np.array_equal(a.astype(np.float32)[:-1], b[:-1]))
+        self.assertEqual(np.signbit(b[1]), True)
+        self.assertTrue(np.isnan(b[-1]))
+        self.assertTrue(np.all(a.astype(np.float64) == JArray.of(a, dtype=JDouble)))
+        self.assertTrue(np.all(a.astype(np.int32)[:-3] == JArray.of(a[:-3], dtype=JInt)))
+
+    @common.requireNumpy
+    def testArrayAssignWiden(self):
+        a = np.arange(1000).astype(np.uint16) * 60
+        ja = JArray(JInt)(len(a))
+        ja[:] = a
+        self.assertTrue(np.all(a == ja))
+        ja = JArray(JLong)(len(a))
+        ja[::2] = a[::2]
+        self.assertTrue(np.all(a[::2] == ja[::2]))
+        self.assertTrue(np.all(np.array(ja)[1::2] == 0))
+        h = np.linspace(-100, 100, 1000).astype(np.float16)
+        jf = JArray(JFloat)(h)
+        self.assertTrue(np.all(h == jf))
+        jf[10:20] = h[::-1][10:20]
+        self.assertTrue(np.all(h[::-1][10:20] == jf[10:20]))
+
     @common.requireNumpy
     def testArrayOfExc(self):
-        a = np.random.randint(0, 2 * 8 - 1, size=1, dtype=np.uint8)
-        with self.assertRaises(TypeError):
-            JArray.of(a)
-        a = np.random.randint(0, 2 * 16 - 1, size=1, dtype=np.uint16)
-        with self.assertRaises(TypeError):
-            JArray.of(a)
-        a = np.random.randint(0, 2 * 32 - 1, size=1, dtype=np.uint32)
+        a = np.zeros(1, dtype=np.complex64)
         with self.assertRaises(TypeError):
             JArray.of(a)
         a = np.random.randint(0, 2 * 64 - 1, size=1, dtype=np.uint64)
@@ -0,0 +1,114 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+from jpype.types import *
+import common
+
+try:
+    import numpy as np
+except ImportError:
+    pass
+
+
+class ArrayBufferTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.data = list(range(100))
+
+    def testModes(self):
+        ja = JArray(JInt)(self.data)
+        for mode in ("pin", "copy", "detach"):
+            b = ja.toBuffer(mode)
+            self.assertEqual(b.mode, mode)
+            self.assertEqual(memoryview(b).tolist(), self.data)
+        self.assertEqual(ja.toBuffer().mode, "copy")
+        with self.assertRaises(ValueError):
+            ja.toBuffer("steal")
+
+    def testTypes(self):
+        for cls, code in ((JBoolean, '?'), (JByte, 'b'), (JChar, 'H'), (JShort, 'h'),
+                          (JInt, 'i'), (JLong, 'q'), (JFloat, 'f'), (JDouble, 'd')):
+            ja = JArray(cls)(5)
+            mv = memoryview(ja.toBuffer("copy"))
+            self.assertEqual(mv.format, code)
+            self.assertEqual(len(mv), 5)
+
+    def testCopyOwnership(self):
+        ja = JArray(JInt)(self.data)
+        b = ja.toBuffer("copy")
+        self.assertIs(b.array, ja)
+        mv = memoryview(b)
+        self.assertFalse(mv.readonly)
+        mv[0] = 1000
+        self.assertEqual(ja[0], 0)
+        ja[1] = 2000
+        self.assertEqual(mv[1], 1)
+        b.refresh()
+        self.assertEqual(mv[0], 0)
+        self.assertEqual(mv[1], 2000)
+
+    def testDetach(self):
+        ja = JArray(JDouble)([1.5, 2.5])
+        b = ja.toBuffer("detach")
+        self.assertIsNone(b.array)
+        del ja
+        self.assertEqual(memoryview(b).tolist(), [1.5, 2.5])
+        with self.assertRaises(ValueError):
+            b.refresh()
+
+    def testPin(self):
+        ja = JArray(JInt)(self.data)
+        b = ja.toBuffer("pin")
+        self.assertIs(b.array, ja)
+        mv = memoryview(b)
+        self.assertTrue(mv.readonly)
+        self.assertEqual(mv.tolist(), self.data)
+        mv.release()
+
+    def testSlice(self):
+        ja = JArray(JLong)(self.data)
+        for mode in ("pin", "copy", "detach"):
+            self.assertEqual(memoryview(ja[10:20].toBuffer(mode)).tolist(), self.data[10:20])
+            self.assertEqual(memoryview(ja[1:50:7].toBuffer(mode)).tolist(), self.data[1:50:7])
+            self.assertEqual(memoryview(ja[::-3].toBuffer(mode)).tolist(), self.data[::-3])
+
+    def testEmpty(self):
+        ja = JArray(JInt)(0)
+        self.assertEqual(len(memoryview(ja.toBuffer("copy"))), 0)
+
+    def testStats(self):
+        old = _jpype.enableStats(True)
+        try:
+            _jpype.resetStats()
+            ja = JArray(JInt)(self.data)
+            memoryview(ja.toBuffer("detach"))
+            self.assertEqual(_jpype.stats()['array_copy_bytes'], 400)
+            memoryview(ja.toBuffer("pin"))
+            self.assertEqual(_jpype.stats()['array_pins'], 1)
+        finally:
+            _jpype.enableStats(old)
+
+    @common.requireNumpy
+    def testNumpy(self):
+        ja = JArray(JDouble)(self.data)
+        a = np.asarray(ja.toBuffer("detach"))
+        self.assertEqual(a.dtype, np.float64)
+        self.assertEqual(a.ctypes.data % 64, 0)
+        self.assertTrue(np.array_equal(a, np.arange(100.0)))
@@ -0,0 +1,84 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+from jpype.types import *
+import common
+
+try:
+    import numpy as np
+except ImportError:
+    pass
+
+
+class ArrayParallelTestCase(common.JPypeTestCase):
+    """Transfers split across workers must match the serial result."""
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        # Split everything so the parallel paths are exercised
+        self.policy = _jpype.setArrayParallel(0, 4)
+
+    def tearDown(self):
+        _jpype.setArrayParallel(*self.policy)
+
+    def testPolicy(self):
+        self.assertEqual(_jpype.setArrayParallel(0, 4), (0, 4))
+        with self.assertRaises(ValueError):
+            _jpype.setArrayParallel(-1, 0)
+
+    def testSetRange(self):
+        data = list(range(1001))
+        for cls in (JByte, JShort, JInt, JLong, JFloat, JDouble):
+            ja = JArray(cls)(1001)
+            ja[:] = memoryview(JArray(JLong)([i % 100 for i in data]))
+            self.assertEqual(list(ja), [i % 100 for i in data])
+
+    def testSetSlice(self):
+        ja = JArray(JInt)(100)
+        ja[1:100:3] = memoryview(JArray(JInt)(list(range(33))))
+        expected = [0] * 100
+        expected[1:100:3] = list(range(33))
+        self.assertEqual(list(ja), expected)
+
+    @common.requireNumpy
+    def testFromNumpy(self):
+        a = np.arange(10007, dtype=np.float64)
+        ja = JArray(JDouble)(a)
+        self.assertTrue(np.array_equal(np.array(ja), a))
+        b = a[::-3]
+        jb = JArray(JDouble)(len(b))
+        jb[:] = b
+        self.assertTrue(np.array_equal(np.array(jb), b))
+
+    @common.requireNumpy
+    def testMultiFromNumpy(self):
+        a = np.arange(3 * 17 * 11, dtype=np.int32).reshape((3, 17, 11))
+        ja = JArray(JInt, 3)(a)
+        self.assertTrue(np.array_equal(np.array(ja), a))
+        b = a.transpose()
+        jb = JArray(JInt, 3)(b)
+        self.assertTrue(np.array_equal(np.array(jb), b))
+
+    def testMultiToView(self):
+        ja = JArray(JInt, 2)(13)
+        for i in range(13):
+            ja[i] = JArray(JInt)(list(range(i * 7, i * 7 + 7)))
+        mv = memoryview(ja)
+        self.assertEqual(mv.shape, (13, 7))
+        self.assertEqual(mv.tolist(), [list(range(i * 7, i * 7 + 7)) for i in range(13)])
@@ -467,3 +467,28 @@ class BoxedTestCase(common.JPypeTestCase):
         self.assertIsInstance(java.lang.Long(1), java.lang.Number)
         self.assertIsInstance(java.lang.Float(1), java.lang.Number)
         self.assertIsInstance(java.lang.Double(1), java.lang.Number)
+
+    def testBoxValueOf(self):
+        ident = java.util.IdentityHashMap()
+        ident.put(12, None)
+        ident.put(12, None)
+        self.assertEqual(ident.size(), 1)
+        ident.put(JInt(12), None)
+        self.assertEqual(ident.size(), 2)
+        ident.put(JInt(12), None)
+        self.assertEqual(ident.size(), 2)
+        ident.put(True, None)
+        ident.put(True, None)
+        self.assertEqual(ident.size(), 3)
+
+    def testBoxLarge(self):
+        lst = java.util.ArrayList()
+        for i in (-129, 128, 2**40, -2**63):
+            lst.add(i)
+            self.assertIsInstance(lst.get(lst.size() - 1), java.lang.Long)
+            self.assertEqual(lst.get(lst.size() - 1), i)
+        lst.add(JInt(100000))
+        self.assertIsInstance(lst.get(lst.size() - 1), java.lang.Integer)
+        self.assertEqual(lst.get(lst.size() - 1), 100000)
+        lst.add(1.5)
+        self.assertIsInstance(lst.get(lst.size() - 1), java.lang.Double)
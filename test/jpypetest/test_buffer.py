@@ -277,3 +277,26 @@ class BufferTestCase(common.JPypeTestCase):
     @common.unittest.skipUnless(haveNumpy(), "numpy not available")
     def testDoubleToNP3D(self):
         self.executeFloatTest(JDouble, (11, 10, 9), np.float64, "d")
+
+    @common.unittest.skipUnless(haveNumpy(), "numpy not available")
+    def testIntToNP6D(self):
+        self.executeIntTest(JInt, [-2**31, 2**31 - 1],
+                            (3, 2, 4, 2, 3, 2), np.int32, "i")
+
+    @common.unittest.skipUnless(haveNumpy(), "numpy not available")
+    def testDoubleToNP6D(self):
+        self.executeFloatTest(JDouble, (3, 2, 4, 2, 3, 2), np.float64, "d")
+
+    @common.unittest.skipUnless(haveNumpy(), "numpy not available")
+    def testDoubleEmptyNP3D(self):
+        data = np.zeros((3, 0, 2), dtype=np.float64)
+        a = JArray(JDouble, 3)(data)
+        self.assertEqual(len(a), 3)
+        self.assertEqual(len(a[0]), 0)
+
+    def testIntList6D(self):
+        data = [[[[[[1, 2]] * 2] * 2] * 2] * 2] * 2
+        a = JArray(JInt, 6)(data)
+        mv = memoryview(a)
+        self.assertEqual(mv.shape, (2,) * 6)
+        self.assertEqual(mv.tolist(), data)
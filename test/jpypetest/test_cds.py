@@ -0,0 +1,85 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import jpype
+import jpype.cds
+import common
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+root = os.path.dirname(os.path.abspath(os.path.dirname(__file__)))
+cp = os.path.join(root, 'classes').replace('\\', '/')
+
+_STARTUP = """
+import sys, jpype
+args = sys.argv[2:]
+jpype.startJVM(*args, classpath=[%r], cdsArchive=sys.argv[1] or None)
+jpype.JClass('jpype.array.TestArray')
+mx = jpype.JClass('java.lang.management.ManagementFactory').getRuntimeMXBean()
+print(jpype.java.lang.System.getProperty('java.vm.info'))
+for arg in mx.getInputArguments():
+    print(arg)
+""" % cp
+
+
+def _startup(archive, *args):
+    env = dict(os.environ)
+    env['PYTHONPATH'] = os.pathsep.join([i for i in sys.path if i])
+    out = subprocess.check_output([sys.executable, '-c', _STARTUP, archive or ''] + list(args), env=env)
+    return out.decode().splitlines()
+
+
+class ClassDataSharingTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        if common.fast:
+            raise unittest.SkipTest("fast")
+        if jpype.getJVMVersion() < (13,):
+            raise unittest.SkipTest("dynamic CDS requires Java 13")
+        self.tmp = tempfile.mkdtemp()
+        self.archive = os.path.join(self.tmp, "jpype.jsa")
+
+    def tearDown(self):
+        if os.path.exists(self.archive):
+            os.remove(self.archive)
+        os.rmdir(self.tmp)
+
+    def testCreateArchive(self):
+        out = jpype.cds.createArchive(self.archive, classpath=[cp],
+                                      classes=['jpype.array.TestArray'])
+        self.assertEqual(out, os.path.abspath(self.archive))
+        self.assertTrue(os.path.exists(self.archive))
+        # The archive must be usable, -Xshare:on fails if it cannot be mapped
+        _startup(self.archive, "-Xshare:on")
+
+    def testCreateOnFirstUse(self):
+        _startup(self.archive)
+        self.assertTrue(os.path.exists(self.archive))
+        _startup(self.archive, "-Xshare:on")
+
+    def testStartupShared(self):
+        jpype.cds.createArchive(self.archive, classpath=[cp],
+                                classes=['jpype.array.TestArray'])
+        out = _startup(self.archive)
+        # The VM reports sharing in its info string when an archive is mapped
+        self.assertIn("sharing", out[0])
+        self.assertIn("-XX:SharedArchiveFile=%s" % self.archive, out[1:])
+        self.assertIn("-Xshare:auto", out[1:])
@@ -85,3 +85,89 @@ class ClassHintsTestCase(common.JPypeTestCase):
         cht.call(MyImpl())
         self.assertIsInstance(cht.input, self.MyCustom)
         self.assertIsInstance(cht.input.arg, MyImpl)
+
+    def testConvertAttributeInstance(self):
+        cht = self.ClassHintsTest
+
+        class Plain(object):
+            pass
+
+        @jpype.JConversion(self.Custom, attribute="fooInstance")
+        def PlainToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        with self.assertRaises(TypeError):
+            cht.call(Plain())
+        obj = Plain()
+        obj.fooInstance = 1
+        cht.call(obj)
+        self.assertIs(cht.input.arg, obj)
+        with self.assertRaises(TypeError):
+            cht.call(Plain())
+
+    def testConvertRepeated(self):
+        cht = self.ClassHintsTest
+
+        class Repeated(object):
+            pass
+
+        @jpype.JConversion(self.Custom, instanceof=Repeated)
+        def RepeatedToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        for i in range(3):
+            obj = Repeated()
+            cht.call(obj)
+            self.assertIs(cht.input.arg, obj)
+
+    def testConvertRegisterLater(self):
+        import abc
+        cht = self.ClassHintsTest
+
+        class LateBase(abc.ABC):
+            pass
+
+        class Late(object):
+            pass
+
+        @jpype.JConversion(self.Custom, instanceof=LateBase)
+        def LateToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        with self.assertRaises(TypeError):
+            cht.call(Late())
+        LateBase.register(Late)
+        obj = Late()
+        cht.call(obj)
+        self.assertIs(cht.input.arg, obj)
+
+    def testConvertProtocol(self):
+        import typing
+        if not hasattr(typing, "runtime_checkable"):
+            raise common.unittest.SkipTest("runtime_checkable required")
+        cht = self.ClassHintsTest
+
+        @typing.runtime_checkable
+        class SupportsFooProto(typing.Protocol):
+            def fooProto(self):
+                pass
+
+        class Duck(object):
+            pass
+
+        @jpype.JConversion(self.Custom, instanceof=SupportsFooProto)
+        def DuckToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        with self.assertRaises(TypeError):
+            cht.call(Duck())
+        obj = Duck()
+        obj.fooProto = lambda: None
+        cht.call(obj)
+        self.assertIs(cht.input.arg, obj)
+        with self.assertRaises(TypeError):
+            cht.call(Duck())
+        Duck.fooProto = lambda self: None
+        obj = Duck()
+        cht.call(obj)
+        self.assertIs(cht.input.arg, obj)
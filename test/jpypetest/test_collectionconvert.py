@@ -0,0 +1,186 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import jpype
+from jpype.types import *
+import common
+
+
+class CollectionConvertTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.Map = JClass("java.util.Map")
+        self.Collection = JClass("java.util.Collection")
+        self.HashMap = JClass("java.util.HashMap")
+        self.ArrayList = JClass("java.util.ArrayList")
+
+    def testDict(self):
+        m = JObject({"a": 1, "b": 2.5, "c": True, "d": None, "e": "s"}, self.Map)
+        self.assertEqual(m.getClass(), self.HashMap.class_)
+        self.assertEqual(m["a"], 1)
+        self.assertIsInstance(m["a"], JClass("java.lang.Long"))
+        self.assertIsInstance(m["b"], JClass("java.lang.Double"))
+        self.assertIsInstance(m["c"], JClass("java.lang.Boolean"))
+        self.assertIsNone(m["d"])
+        self.assertIsInstance(m["e"], JClass("java.lang.String"))
+
+    def testNested(self):
+        obj = {"name": "job", "hosts": ["a", "b"], "limits": {"cpu": 2, "mem": [1, 2]}}
+        m = JObject(obj, self.Map)
+        self.assertIsInstance(m["hosts"], self.ArrayList)
+        self.assertIsInstance(m["limits"], self.HashMap)
+        self.assertIsInstance(m["limits"]["mem"], self.ArrayList)
+        self.assertEqual(m["limits"]["mem"][1], 2)
+
+    def testList(self):
+        lst = JObject([1, "a", (2, 3), {"k": "v"}], self.Collection)
+        self.assertEqual(lst.getClass(), self.ArrayList.class_)
+        self.assertEqual(lst.size(), 4)
+        items = list(lst)
+        self.assertIsInstance(items[2], self.ArrayList)
+        self.assertIsInstance(items[3], self.HashMap)
+        # Unlike Arrays.asList the copy is growable
+        lst.add("b")
+        self.assertEqual(lst.size(), 5)
+
+    def testJavaElements(self):
+        obj = JClass("java.lang.Object")()
+        items = list(JObject([obj, JInt(1), JString("s")], self.Collection))
+        self.assertTrue(items[0].equals(obj))
+        self.assertIsInstance(items[1], JClass("java.lang.Integer"))
+
+    def testUnconvertible(self):
+        with self.assertRaises(TypeError):
+            JObject([object()], self.Collection)
+
+    def testRecursive(self):
+        a = []
+        a.append(a)
+        with self.assertRaises(ValueError):
+            JObject(a, self.Collection)
+
+    def testUnicode(self):
+        m = JObject({"é": "\U0001F600"}, self.Map)
+        self.assertEqual(m["é"], "\U0001F600")
+
+    def testToPython(self):
+        obj = {"name": "job", "hosts": ["a", "b"], "limits": {"cpu": 2, "mem": [1.5, None, True]}}
+        m = JObject(obj, self.Map)
+        out = jpype.toPython(m)
+        self.assertEqual(out, obj)
+        self.assertIsInstance(out["hosts"], list)
+        self.assertIsInstance(out["name"], str)
+        self.assertIsInstance(out["limits"]["cpu"], int)
+
+    def testToPythonBoxed(self):
+        lst = self.ArrayList()
+        lst.add(JObject(1, JClass("java.lang.Integer")))
+        lst.add(JObject(2, JClass("java.lang.Short")))
+        lst.add(JObject(1.5, JClass("java.lang.Float")))
+        lst.add(JChar("c"))
+        self.assertEqual(jpype.toPython(lst), [1, 2, 1.5, "c"])
+
+    def testToPythonObject(self):
+        obj = JClass("java.lang.Object")()
+        lst = self.ArrayList()
+        lst.add(obj)
+        out = jpype.toPython(lst)
+        self.assertTrue(out[0].equals(obj))
+
+    def testToPythonSet(self):
+        s = JClass("java.util.TreeSet")()
+        s.add(2)
+        s.add(1)
+        self.assertEqual(jpype.toPython(s), [1, 2])
+
+    def testToPythonScalar(self):
+        self.assertEqual(jpype.toPython(JString("s")), "s")
+        self.assertEqual(jpype.toPython(JObject(1, JClass("java.lang.Long"))), 1)
+
+    def testToPythonCycle(self):
+        lst = self.ArrayList()
+        lst.add(lst)
+        with self.assertRaises(JClass("java.lang.IllegalArgumentException")):
+            jpype.toPython(lst)
+
+    def testToPythonBad(self):
+        with self.assertRaises(TypeError):
+            jpype.toPython(object())
+
+    def testUnboxLong(self):
+        lst = self.ArrayList()
+        for i in (1, -2, 2**40):
+            lst.add(JLong(i))
+        lst.add(JInt(3))
+        out = jpype.unbox(lst)
+        self.assertIsInstance(out, memoryview)
+        self.assertEqual(out.format, "q")
+        self.assertEqual(out.tolist(), [1, -2, 2**40, 3])
+
+    def testUnboxDouble(self):
+        lst = self.ArrayList()
+        lst.add(JInt(1))
+        lst.add(JDouble(2.5))
+        out = jpype.unbox(lst)
+        self.assertEqual(out.format, "d")
+        self.assertEqual(out.tolist(), [1.0, 2.5])
+
+    def testUnboxDtype(self):
+        lst = self.ArrayList()
+        lst.add(JDouble(2.5))
+        lst.add(JInt(4))
+        self.assertEqual(jpype.unbox(lst, dtype=int).tolist(), [2, 4])
+        self.assertEqual(jpype.unbox(lst, dtype=float).tolist(), [2.5, 4.0])
+        with self.assertRaises(ValueError):
+            jpype.unbox(lst, dtype=str)
+
+    def testUnboxArray(self):
+        arr = JArray(JClass("java.lang.Double"))([1.5, 2.5, 3.5])
+        self.assertEqual(jpype.unbox(arr).tolist(), [1.5, 2.5, 3.5])
+
+    def testUnboxEmpty(self):
+        out = jpype.unbox(self.ArrayList(), dtype=float)
+        self.assertEqual(len(out), 0)
+
+    def testUnboxMask(self):
+        lst = self.ArrayList()
+        lst.add(JLong(1))
+        lst.add(None)
+        lst.add(JLong(3))
+        values, mask = jpype.unbox(lst, mask=True)
+        self.assertEqual(values.tolist(), [1, 0, 3])
+        self.assertEqual(mask.format, "?")
+        self.assertEqual(mask.tolist(), [False, True, False])
+
+    def testUnboxNull(self):
+        lst = self.ArrayList()
+        lst.add(None)
+        with self.assertRaises(JClass("java.lang.IllegalArgumentException")):
+            jpype.unbox(lst)
+
+    def testUnboxNotNumber(self):
+        lst = self.ArrayList()
+        lst.add("a")
+        with self.assertRaises(JClass("java.lang.IllegalArgumentException")):
+            jpype.unbox(lst)
+
+    def testUnboxBad(self):
+        with self.assertRaises(TypeError):
+            jpype.unbox(object())
+        with self.assertRaises(JClass("java.lang.IllegalArgumentException")):
+            jpype.unbox(JString("a"))
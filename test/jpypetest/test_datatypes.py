@@ -0,0 +1,129 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+from jpype.types import *
+import common
+import datetime
+import decimal
+
+
+class DataTypesTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.sql = jpype.JPackage("java").sql
+        self.time = jpype.JPackage("java").time
+        self.BigDecimal = JClass("java.math.BigDecimal")
+
+    def testTimestamp(self):
+        ts = self.sql.Timestamp.valueOf("2020-01-02 03:04:05.123456789")
+        self.assertEqual(ts._py(), datetime.datetime(2020, 1, 2, 3, 4, 5, 123456))
+
+    def testSQLDate(self):
+        d = self.sql.Date.valueOf("1969-12-31")
+        self.assertEqual(d._py(), datetime.date(1969, 12, 31))
+
+    def testSQLTime(self):
+        t = self.sql.Time.valueOf("23:59:58")
+        self.assertEqual(t._py(), datetime.time(23, 59, 58))
+
+    def testLocalDate(self):
+        self.assertEqual(self.time.LocalDate.of(1, 1, 1)._py(), datetime.date(1, 1, 1))
+        self.assertEqual(self.time.LocalDate.of(2000, 2, 29)._py(), datetime.date(2000, 2, 29))
+        self.assertEqual(self.time.LocalDate.of(9999, 12, 31)._py(), datetime.date(9999, 12, 31))
+
+    def testLocalTime(self):
+        t = self.time.LocalTime.of(12, 30, 15, 999999999)
+        self.assertEqual(t._py(), datetime.time(12, 30, 15, 999999))
+
+    def testLocalDateTime(self):
+        ldt = self.time.LocalDateTime.of(1900, 3, 1, 0, 0, 1, 1000)
+        self.assertEqual(ldt._py(), datetime.datetime(1900, 3, 1, 0, 0, 1, 1))
+
+    def testInstant(self):
+        i = self.time.Instant.ofEpochSecond(-1, 500000000)
+        self.assertEqual(i._py(), datetime.datetime(1969, 12, 31, 23, 59, 59, 500000,
+                                                    tzinfo=datetime.timezone.utc))
+
+    def testOffsetDateTime(self):
+        offset = self.time.ZoneOffset.ofHoursMinutes(5, 30)
+        odt = self.time.OffsetDateTime.of(2021, 6, 5, 10, 0, 0, 0, offset)
+        tz = datetime.timezone(datetime.timedelta(hours=5, minutes=30))
+        out = odt._py()
+        self.assertEqual(out, datetime.datetime(2021, 6, 5, 10, 0, tzinfo=tz))
+        self.assertEqual(out.utcoffset(), datetime.timedelta(hours=5, minutes=30))
+
+    def testZonedDateTime(self):
+        zdt = self.time.ZonedDateTime.of(2021, 1, 1, 0, 0, 0, 0, self.time.ZoneId.of("UTC"))
+        self.assertEqual(zdt._py().utcoffset(), datetime.timedelta(0))
+
+    def testZonedDateTimeOffset(self):
+        offset = self.time.ZoneOffset.ofHours(-3)
+        zdt = self.time.ZonedDateTime.of(2021, 1, 1, 12, 0, 0, 0, offset)
+        out = zdt._py()
+        self.assertEqual(out.utcoffset(), datetime.timedelta(hours=-3))
+        self.assertIsInstance(out.tzinfo, datetime.timezone)
+
+    def testZonedDateTimeRegion(self):
+        zone = self.time.ZoneId.of("America/New_York")
+        # 01:30 occurs twice when daylight saving time ends
+        zdt = self.time.ZonedDateTime.of(2021, 11, 7, 1, 30, 0, 0, zone)
+        later = zdt.withLaterOffsetAtOverlap()
+        out = zdt._py()
+        out2 = later._py()
+        self.assertEqual(out.replace(tzinfo=None), datetime.datetime(2021, 11, 7, 1, 30))
+        self.assertEqual(out.utcoffset(), datetime.timedelta(hours=-4))
+        self.assertEqual(out2.utcoffset(), datetime.timedelta(hours=-5))
+        try:
+            import zoneinfo
+            zoneinfo.ZoneInfo("America/New_York")
+        except Exception:
+            # Without zoneinfo data only the offset is kept
+            self.assertIsInstance(out.tzinfo, datetime.timezone)
+            return
+        self.assertEqual(str(out.tzinfo), "America/New_York")
+        self.assertEqual(out.fold, 0)
+        self.assertEqual(out2.fold, 1)
+
+    def testBigDecimal(self):
+        for s in ("0", "-123.4500", "1E+5", "3.14159", "-0.000001",
+                  "123456789012345678901234567890.123456789"):
+            self.assertEqual(self.BigDecimal(s)._py(), decimal.Decimal(s))
+        self.assertEqual(str(self.BigDecimal("-123.4500")._py()), "-123.4500")
+
+    def testBigDecimalMinLong(self):
+        v = self.BigDecimal.valueOf(JClass("java.lang.Long").MIN_VALUE, 2)
+        self.assertEqual(v._py(), decimal.Decimal(-2**63).scaleb(-2))
+
+    def testColumn(self):
+        values = [self.sql.Date.valueOf("2001-02-03"), None,
+                  self.BigDecimal("1.5"), JString("other"),
+                  self.time.Instant.ofEpochSecond(0)]
+        out = _jpype.dataColumnToPython(values)
+        self.assertEqual(out[0], datetime.date(2001, 2, 3))
+        self.assertIsNone(out[1])
+        self.assertEqual(out[2], decimal.Decimal("1.5"))
+        self.assertEqual(out[3], "other")
+        self.assertEqual(out[4], datetime.datetime(1970, 1, 1, tzinfo=datetime.timezone.utc))
+
+    def testColumnBad(self):
+        with self.assertRaises(TypeError):
+            _jpype.dataColumnToPython([object()])
+        with self.assertRaises(TypeError):
+            _jpype.dataColumnToPython(1)
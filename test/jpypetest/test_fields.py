@@ -222,3 +222,39 @@ class FieldsTestCase(common.JPypeTestCase):
         self.assertEqual(self.cls.static_object_field, "Charlie")
         self.assertEqual(self.obj.getStaticObject(), "Charlie")
         self.assertEqual(self.cls.getStaticObject(), "Charlie")
+
+    def testGetFields(self):
+        self.obj.bool_field = True
+        self.obj.char_field = 'a'
+        self.obj.int_field = 5
+        self.obj.long_field = 2**40
+        self.obj.double_field = 1.5
+        self.obj.object_field = "Bob"
+        values = jpype.getFields(self.obj, "bool_field", "char_field",
+                                 "int_field", "long_field", "double_field",
+                                 "object_field")
+        self.assertEqual(values, (True, 'a', 5, 2**40, 1.5, "Bob"))
+        self.assertIs(type(values[2]), int)
+        self.assertIs(type(values[4]), float)
+        self.assertEqual(jpype.getFields(self.obj, "final_int_field"), (67890,))
+
+    def testGetFieldsMany(self):
+        objs = [self.cls() for i in range(5)]
+        for i, obj in enumerate(objs):
+            obj.int_field = i
+            obj.float_field = i / 2
+        rows = jpype.getFields(objs, "int_field", "float_field")
+        self.assertEqual(rows, [(i, i / 2) for i in range(5)])
+        self.assertEqual(jpype.getFields([], "int_field"), [])
+
+    def testGetFieldsFail(self):
+        with self.assertRaises(AttributeError):
+            jpype.getFields(self.obj, "no_such_field")
+        with self.assertRaises(AttributeError):
+            jpype.getFields(self.obj, "static_int_field")
+        with self.assertRaises(AttributeError):
+            jpype.getFields(self.obj, "getInt")
+        with self.assertRaises(TypeError):
+            jpype.getFields([self.obj, object()], "int_field")
+        with self.assertRaises(TypeError):
+            jpype.getFields(JInt(1), "int_field")
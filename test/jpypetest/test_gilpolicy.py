@@ -0,0 +1,177 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+from jpype import JImplementationFor, JGILPolicy
+import common
+import threading
+
+
+class GILPolicyTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.old = _jpype.setAdaptiveGIL(False)
+        _jpype.resetStats()
+        Math = jpype.JClass("java.lang.Math")
+        Integer = jpype.JClass("java.lang.Integer")
+        Thread = jpype.JClass("java.lang.Thread")
+        BitSet = jpype.JClass("java.util.BitSet")
+        methods = (Math.min, Integer.rotateLeft, Integer.rotateRight,
+                   Thread.sleep, BitSet.get, BitSet.cardinality)
+        self.policies = [(m, m._gilPolicy) for m in methods]
+
+    def tearDown(self):
+        _jpype.enableStats(False)
+        _jpype.setAdaptiveGIL(*self.old)
+        for method, policy in self.policies:
+            method._gilPolicy = policy
+
+    def testSetAdaptive(self):
+        old = _jpype.setAdaptiveGIL(True, 5000)
+        self.assertEqual(old[0], False)
+        self.assertEqual(_jpype.setAdaptiveGIL(False), (True, 5000))
+        with self.assertRaises(ValueError):
+            _jpype.setAdaptiveGIL(True, -1)
+
+    def testPolicyProperty(self):
+        method = jpype.JClass("java.lang.Math").min
+        self.assertEqual(method._gilPolicy, "default")
+        try:
+            method._gilPolicy = "hold"
+            self.assertEqual(method._gilPolicy, "hold")
+            method._gilPolicy = "release"
+            self.assertEqual(method._gilPolicy, "release")
+            with self.assertRaises(ValueError):
+                method._gilPolicy = "sometimes"
+            with self.assertRaises(TypeError):
+                method._gilPolicy = 1
+        finally:
+            method._gilPolicy = "default"
+
+    def testHold(self):
+        Math = jpype.JClass("java.lang.Math")
+        Math.min._gilPolicy = "hold"
+        try:
+            _jpype.enableStats(True)
+            for i in range(10):
+                self.assertEqual(Math.min(i, 5), min(i, 5))
+            _jpype.enableStats(False)
+        finally:
+            Math.min._gilPolicy = "default"
+        stats = _jpype.stats()
+        self.assertEqual(stats['gil_held'], 10)
+
+    def testRelease(self):
+        Math = jpype.JClass("java.lang.Math")
+        Math.min._gilPolicy = "release"
+        _jpype.setAdaptiveGIL(True, 10**9)
+        try:
+            _jpype.enableStats(True)
+            for i in range(40):
+                Math.min(i, 5)
+            _jpype.enableStats(False)
+        finally:
+            Math.min._gilPolicy = "default"
+        stats = _jpype.stats()
+        self.assertEqual(stats['gil_held'], 0)
+        self.assertGreaterEqual(stats['gil_releases'], 40)
+
+    def testAdaptiveShort(self):
+        Integer = jpype.JClass("java.lang.Integer")
+        _jpype.setAdaptiveGIL(True, 10**7)
+        for i in range(40):
+            self.assertEqual(Integer.rotateLeft(1, i % 8), 1 << (i % 8))
+        self.assertEqual(Integer.rotateLeft._stats()['gil_short'], 1)
+        _jpype.enableStats(True)
+        Integer.rotateLeft(1, 1)
+        _jpype.enableStats(False)
+        self.assertEqual(_jpype.stats()['gil_held'], 1)
+
+    def testAdaptiveDisabled(self):
+        Integer = jpype.JClass("java.lang.Integer")
+        _jpype.setAdaptiveGIL(True, 10**7)
+        for i in range(40):
+            Integer.rotateRight(1, 1)
+        _jpype.setAdaptiveGIL(False)
+        _jpype.enableStats(True)
+        Integer.rotateRight(1, 1)
+        _jpype.enableStats(False)
+        self.assertEqual(_jpype.stats()['gil_held'], 0)
+
+    def testAdaptiveLong(self):
+        Thread = jpype.JClass("java.lang.Thread")
+        _jpype.setAdaptiveGIL(True, 1000)
+        for i in range(20):
+            Thread.sleep(2)
+        self.assertEqual(Thread.sleep._stats()['gil_short'], 0)
+
+    def testHoldBlocksThreads(self):
+        # A held call keeps other Python threads out while it runs.
+        Thread = jpype.JClass("java.lang.Thread")
+        Thread.sleep._gilPolicy = "hold"
+        ticks = []
+        done = threading.Event()
+
+        def work():
+            while not done.is_set():
+                ticks.append(1)
+                done.wait(0.001)
+        t = threading.Thread(target=work)
+        try:
+            t.start()
+            while not ticks:
+                done.wait(0.001)
+            del ticks[:]
+            Thread.sleep(50)
+            held = len(ticks)
+        finally:
+            Thread.sleep._gilPolicy = "default"
+            done.set()
+            t.join()
+        self.assertLessEqual(held, 1)
+
+    def testWaitStats(self):
+        _jpype.enableStats(True)
+        jpype.JClass("java.lang.Math").abs(-1)
+        _jpype.enableStats(False)
+        stats = _jpype.stats()
+        self.assertIn('gil_wait_ns', stats)
+        self.assertGreaterEqual(stats['gil_wait_ns'], 0)
+
+    def testCustomizer(self):
+        @JImplementationFor("java.util.BitSet")
+        @JGILPolicy("hold", "get", "cardinality")
+        class _BitSetCustomizer(object):
+            pass
+        BitSet = jpype.JClass("java.util.BitSet")
+        try:
+            self.assertEqual(BitSet.get._gilPolicy, "hold")
+            self.assertEqual(BitSet.cardinality._gilPolicy, "hold")
+            self.assertEqual(BitSet.set._gilPolicy, "default")
+            b = BitSet()
+            b.set(3)
+            self.assertTrue(b.get(3))
+            self.assertEqual(b.cardinality(), 1)
+        finally:
+            BitSet.get._gilPolicy = "default"
+            BitSet.cardinality._gilPolicy = "default"
+
+    def testCustomizerBadPolicy(self):
+        with self.assertRaises(ValueError):
+            JGILPolicy("never", "get")
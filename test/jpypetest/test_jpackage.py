@@ -74,3 +74,16 @@ class JPackageTestCase(common.JPypeTestCase):
         JL = JPackage("java.lng")
         with self.assertRaisesRegex(AttributeError, "Java package 'java.lng' is not valid"):
             getattr(JL, "foo")
+
+    def testIndexJar(self):
+        # Packages held in jars are answered from the package index
+        self.assertTrue(_jpype.isPackage("org.jpype.mrjar"))
+        self.assertTrue(_jpype.isPackage("org.jpype.mrjar.sub"))
+        self.assertFalse(_jpype.isPackage("org.jpype.mrjar.nosuch"))
+        self.assertFalse(_jpype.isPackage("org.jpype.mrjar.A"))
+        self.assertIn("C", dir(JPackage("org.jpype.mrjar.sub")))
+
+    def testIndexDirectory(self):
+        # Directories on the class path are still probed directly
+        self.assertTrue(_jpype.isPackage("jpype.common"))
+        self.assertIn("Fixture", dir(JPackage("jpype.common")))
@@ -15,6 +15,7 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import _jpype
 import jpype
 from jpype import JString, java, JArray, JClass, JByte, JShort, JInt, JLong, JFloat, JDouble, JChar, JBoolean, JObject
 import sys
@@ -190,3 +191,63 @@ class OverloadTestCase(common.JPypeTestCase):
             pass
         else:
             self.assertEqual('B', testdefault.defaultMethod())
+
+    def testBind(self):
+        test1 = self.__jp.Test1()
+        self.assertEqual('int', test1.testPrimitive.bind(JInt)(5))
+        self.assertEqual('long', test1.testPrimitive.bind(JLong)(5))
+        self.assertEqual('Integer', test1.testPrimitive.bind(java.lang.Integer)(5))
+        self.assertEqual('A', test1.testMostSpecific.bind(self._aclass)(self._c))
+        self.assertEqual('B', test1.testMostSpecific.bind(self._bclass)(self._c))
+
+    def testBindUnbound(self):
+        test1 = self.__jp.Test1()
+        short = self.__jp.Test1.testPrimitive.bind(JShort)
+        self.assertIsNone(short.__self__)
+        self.assertEqual('short', short(test1, 5))
+        self.assertEqual('static B',
+                         self.__jp.Test1.testInstanceVsClass.bind(self._bclass)(self._c))
+        self.assertEqual('instance A',
+                         test1.testInstanceVsClass.bind(self._aclass)(self._c))
+
+    def testBindVarArgs(self):
+        test1 = self.__jp.Test1()
+        f = test1.testVarArgs.bind(self._aclass, JArray(self._bclass))
+        self.assertEqual('A,B...', f(self._a, [self._b]))
+        self.assertEqual('A,B...', f(self._a, self._b, self._b))
+
+    def testBindFail(self):
+        test1 = self.__jp.Test1()
+        with self.assertRaisesRegex(TypeError, "No overload"):
+            test1.testPrimitive.bind(JString)
+        with self.assertRaises(TypeError):
+            test1.testPrimitive.bind(1)
+        f = test1.testPrimitive.bind(JInt)
+        with self.assertRaisesRegex(TypeError, "bound overload"):
+            f("x")
+        with self.assertRaises(TypeError):
+            f(1, 2)
+
+    def testBindRepr(self):
+        test1 = self.__jp.Test1()
+        f = test1.testMostSpecific.bind(self._aclass)
+        self.assertIsInstance(f, _jpype._JOverload)
+        self.assertIn("testMostSpecific(", repr(f))
+        self.assertIn("bound", repr(f))
+        self.assertEqual("testMostSpecific", f.__name__)
+
+    def testThreadedCache(self):
+        # Threads alternating argument types must each get their own overload
+        from concurrent.futures import ThreadPoolExecutor
+        test1 = self.__jp.Test1()
+        cases = [(JInt(5), 'int'), (JDouble(5), 'double'),
+                 (java.lang.Long(5), 'Long'), (JChar('5'), 'char')]
+
+        def work(offset):
+            for i in range(500):
+                arg, expected = cases[(i + offset) % len(cases)]
+                if str(test1.testPrimitive(arg)) != expected:
+                    return False
+            return True
+        with ThreadPoolExecutor(4) as pool:
+            self.assertTrue(all(pool.map(work, range(4))))
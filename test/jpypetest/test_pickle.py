@@ -81,3 +81,47 @@ class PickleTestCase(common.JPypeTestCase):
         with self.assertRaises(java.io.NotSerializableException):
             with open("test.pic", "wb") as fd:
                 JPickler(fd).dump(s)
+
+    def testProtocols(self):
+        import io
+        s = java.util.ArrayList()
+        s.add("test")
+        for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+            fd = io.BytesIO()
+            JPickler(fd, protocol).dump([s, s, java.lang.String("x")])
+            fd.seek(0)
+            s2 = JUnpickler(fd).load()
+            self.assertEqual(s2[0].get(0), "test")
+            self.assertIs(s2[0], s2[1])
+            self.assertEqual(s2[2], "x")
+
+    def testDispatchDefaultProtocol(self):
+        from jpype.pickle import _JDispatch
+        dispatch = _JDispatch({})
+        self.assertFalse(dispatch._buffers)
+
+    @unittest.skipIf(sys.version_info < (3, 8), "requires protocol 5")
+    def testOutOfBand(self):
+        import io
+        buffers = []
+        items = [java.util.ArrayList(), java.lang.String("large" * 10000)]
+        items[0].add(1)
+        fd = io.BytesIO()
+        JPickler(fd, protocol=5, buffer_callback=buffers.append).dump(items)
+        self.assertEqual(len(buffers), 2)
+        self.assertLess(len(fd.getvalue()), 1000)
+        fd.seek(0)
+        items2 = JUnpickler(fd, buffers=buffers).load()
+        self.assertEqual(items2[0].get(0), 1)
+        self.assertEqual(items2[1], "large" * 10000)
+
+    @unittest.skipIf(sys.version_info < (3, 8), "requires protocol 5")
+    def testOutOfBandBytes(self):
+        import io
+        buffers = []
+        s = java.lang.String("test")
+        fd = io.BytesIO()
+        JPickler(fd, protocol=5, buffer_callback=buffers.append).dump(s)
+        copies = [bytes(b.raw()) for b in buffers]
+        fd.seek(0)
+        self.assertEqual(JUnpickler(fd, buffers=copies).load(), s)
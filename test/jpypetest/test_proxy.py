@@ -15,8 +15,12 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import _jpype
 import contextlib
+import gc
 import sys
+import time
+import weakref
 
 from jpype import *
 import common
@@ -306,6 +310,23 @@ class ProxyTestCase(common.JPypeTestCase):
         self.assertIsInstance(JObject(MyClass(), jrun), jrun)
         self.assertIsInstance(JObject(MyClass()), jobj)
 
+    def testProxySuperInterfaceCast(self):
+        itf1 = JClass("jpype.proxy.TestInterface1")
+        itf2 = JClass("jpype.proxy.TestInterface2")
+        itf3 = JClass("jpype.proxy.TestInterface3")
+
+        @JImplements(itf3, deferred=True)
+        class MyClass(object):
+            @JOverride
+            def testMethod3(self):
+                return "3"
+        obj = MyClass()
+        self.assertIsInstance(JObject(obj, itf2), itf2)
+        jobj = JClass("java.lang.Object")
+        self.assertIsInstance(JObject(obj, jobj), jobj)
+        with self.assertRaises(TypeError):
+            JObject(obj, itf1)
+
     def testProxyConvert(self):
         # This was tests that arguments and "self" both
         # convert to the same object
@@ -496,6 +517,72 @@ class ProxyTestCase(common.JPypeTestCase):
         js = JObject(lambda x: 2 * x, "java.util.function.DoubleUnaryOperator")
         self.assertEqual(js.applyAsDouble(1), 2.0)
 
+    def testFunctionalReuse(self):
+        hc = java.lang.System.identityHashCode
+
+        def f():
+            return 1
+        _jpype.resetStats()
+        _jpype.enableStats(True)
+        try:
+            js1 = JObject(f, "java.util.function.Supplier")
+            js2 = JObject(f, "java.util.function.Supplier")
+            js3 = JObject(f, "java.util.concurrent.Callable")
+        finally:
+            _jpype.enableStats(False)
+        self.assertEqual(hc(js1), hc(js2))
+        self.assertNotEqual(hc(js1), hc(js3))
+        self.assertEqual(js2.get(), 1)
+        self.assertEqual(js3.call(), 1)
+        stats = _jpype.stats()
+        self.assertEqual(stats['proxy_cache_hits'], 1)
+        self.assertEqual(stats['proxy_cache_misses'], 2)
+
+    def testFunctionalReuseDistinct(self):
+        hc = java.lang.System.identityHashCode
+        js1 = JObject(lambda: 1, "java.util.function.Supplier")
+        js2 = JObject(lambda: 2, "java.util.function.Supplier")
+        self.assertNotEqual(hc(js1), hc(js2))
+        self.assertEqual(js1.get(), 1)
+        self.assertEqual(js2.get(), 2)
+
+    def testFunctionalReuseWeak(self):
+        def f():
+            return 1
+        ref = weakref.ref(f)
+        JObject(f, "java.util.function.Supplier")
+        del f
+        for i in range(100):
+            java.lang.System.gc()
+            gc.collect()
+            if ref() is None:
+                break
+            time.sleep(0.01)
+        self.assertIsNone(ref())
+
+    def testFunctionalReuseCycle(self):
+        class Cyclic(object):
+            def __init__(self, value):
+                self.value = value
+                self.cycle = self
+
+            def __call__(self):
+                return self.value
+        obj = Cyclic(1)
+        ref = weakref.ref(obj)
+        JObject(obj, "java.util.function.Supplier")
+        del obj
+        for i in range(100):
+            java.lang.System.gc()
+            gc.collect()
+            if ref() is None:
+                break
+            time.sleep(0.01)
+        self.assertIsNone(ref())
+        for i in range(20):
+            js = JObject(Cyclic(i), "java.util.function.Supplier")
+            self.assertEqual(js.get(), i)
+
 
 @subrun.TestCase(individual=True)
 class TestProxyDefinitionWithoutJVM(common.JPypeTestCase):
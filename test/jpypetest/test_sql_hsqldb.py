@@ -1047,6 +1047,19 @@ class TypeTestCase(common.JPypeTestCase):
             f3 = cu.execute('select * from test').fetchone()
             self.assertEqual(f3[0], datetime.date(2020, 5, 21))
 
+    def testDateDeferredFail(self):
+        from unittest import mock
+        with dbapi2.connect(db_name) as cx, cx.cursor() as cu:
+            cu.execute("create table test(NAME DATE)")
+            cu.execute("insert into test(NAME) values('2012-02-05')")
+            with mock.patch("_jpype.dataColumnToPython", side_effect=TypeError("bad")):
+                cu.execute('select * from test')
+                with self.assertRaises(dbapi2.InterfaceError):
+                    cu.fetchall()
+                cu.execute('select * from test')
+                with self.assertRaises(dbapi2.InterfaceError):
+                    cu.fetchmany(2)
+
     def testTimestamp(self):
         with dbapi2.connect(db_name) as cx, cx.cursor() as cu:
             cu.execute("create table test(NAME TIMESTAMP)")
@@ -0,0 +1,96 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+import common
+import threading
+
+
+class StatsTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        _jpype.resetStats()
+
+    def tearDown(self):
+        _jpype.enableStats(False)
+
+    def testDisabled(self):
+        _jpype.enableStats(False)
+        jpype.java.lang.Math.abs(-1)
+        stats = _jpype.stats()
+        self.assertEqual(stats['calls'], 0)
+        self.assertEqual(stats['frames'], 0)
+
+    def testKeys(self):
+        stats = _jpype.stats()
+        for key in ('calls', 'overload_misses', 'conversion_ns', 'gil_releases',
+                    'gil_release_ns', 'frames', 'global_refs', 'proxy_callbacks'):
+            self.assertIn(key, stats)
+
+    def testEnable(self):
+        self.assertFalse(_jpype.enableStats(True))
+        self.assertTrue(_jpype.enableStats(True))
+
+    def testCalls(self):
+        Math = jpype.JClass("java.lang.Math")
+        _jpype.enableStats(True)
+        for i in range(10):
+            Math.abs(-i)
+        _jpype.enableStats(False)
+        stats = _jpype.stats()
+        self.assertEqual(stats['calls'], 10)
+        self.assertGreaterEqual(stats['frames'], 10)
+        self.assertGreaterEqual(stats['gil_releases'], 10)
+        # First call must resolve the overload, the rest hit the cache
+        self.assertLess(stats['overload_misses'], 10)
+        method = Math.abs._stats()
+        self.assertGreaterEqual(method['calls'], 10)
+
+    def testThreads(self):
+        Math = jpype.JClass("java.lang.Math")
+        _jpype.enableStats(True)
+
+        def work():
+            for i in range(5):
+                Math.abs(-i)
+        threads = [threading.Thread(target=work) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        _jpype.enableStats(False)
+        self.assertEqual(_jpype.stats()['calls'], 20)
+
+    def testProxy(self):
+        @jpype.JImplements("java.lang.Runnable")
+        class MyRunnable(object):
+            @jpype.JOverride
+            def run(self):
+                pass
+        r = jpype.JObject(MyRunnable(), "java.lang.Runnable")
+        _jpype.enableStats(True)
+        r.run()
+        _jpype.enableStats(False)
+        self.assertEqual(_jpype.stats()['proxy_callbacks'], 1)
+
+    def testReset(self):
+        _jpype.enableStats(True)
+        jpype.java.lang.Math.abs(-1)
+        _jpype.resetStats()
+        self.assertEqual(_jpype.stats()['calls'], 0)
@@ -15,8 +15,10 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import _jpype
 import jpype
 import sys
+import threading
 import time
 import common
 import pytest
@@ -67,3 +69,132 @@ class ThreadTestCase(common.JPypeTestCase):
         java.lang.Thread.attachAsDaemon()
         self.assertTrue(java.lang.Thread.isAttached())
         self.assertTrue(java.lang.Thread.currentThread().isDaemon())
+
+    def waitForStats(self, key, value):
+        # Thread exit is seen by the native thread after Python join returns
+        for i in range(500):
+            stats = _jpype.threadStats()
+            if stats[key] >= value:
+                break
+            time.sleep(0.01)
+        return stats
+
+    def runThread(self, func):
+        t = threading.Thread(target=func)
+        t.start()
+        t.join()
+
+    def testThreadStats(self):
+        stats = _jpype.threadStats()
+        for key in ('attached', 'attaches', 'detaches'):
+            self.assertIn(key, stats)
+
+    def testAutoDetach(self):
+        old = _jpype.setThreadPolicy(True)
+        try:
+            before = _jpype.threadStats()
+            self.runThread(lambda: jpype.JString("foo"))
+            after = self.waitForStats('detaches', before['detaches'] + 1)
+            self.assertEqual(after['attaches'], before['attaches'] + 1)
+            self.assertEqual(after['detaches'], before['detaches'] + 1)
+            self.assertEqual(after['attached'], before['attached'])
+        finally:
+            _jpype.setThreadPolicy(*old)
+
+    def testReuse(self):
+        import java
+        old = _jpype.setThreadPolicy(True, True)
+        result = []
+
+        def work():
+            for i in range(3):
+                jpype.JString("foo")
+                java.lang.Thread.detach()
+                result.append(java.lang.Thread.isAttached())
+        try:
+            before = _jpype.threadStats()
+            self.runThread(work)
+            after = self.waitForStats('detaches', before['detaches'] + 1)
+            self.assertEqual(result, [True, True, True])
+            self.assertEqual(after['attaches'], before['attaches'] + 1)
+            self.assertEqual(after['detaches'], before['detaches'] + 1)
+        finally:
+            _jpype.setThreadPolicy(*old)
+
+    def testReuseAttachUser(self):
+        import java
+        old = _jpype.setThreadPolicy(True, True)
+        result = []
+
+        def work():
+            jpype.JString("foo")
+            java.lang.Thread.detach()
+            java.lang.Thread.attach()
+            result.append(java.lang.Thread.currentThread().isDaemon())
+            java.lang.Thread.detach()
+            result.append(java.lang.Thread.isAttached())
+        try:
+            self.runThread(work)
+            self.assertEqual(result, [False, False])
+        finally:
+            _jpype.setThreadPolicy(*old)
+
+    def testReuseAttachDaemon(self):
+        import java
+        old = _jpype.setThreadPolicy(True, True)
+        result = []
+
+        def work():
+            jpype.JString("foo")
+            java.lang.Thread.attachAsDaemon()
+            result.append(java.lang.Thread.currentThread().isDaemon())
+            # Explicit attachments are no longer held for reuse
+            java.lang.Thread.detach()
+            result.append(java.lang.Thread.isAttached())
+        try:
+            self.runThread(work)
+            self.assertEqual(result, [True, False])
+        finally:
+            _jpype.setThreadPolicy(*old)
+
+    def testConcurrentConversions(self):
+        # Conversion caches are shared by all threads
+        from concurrent.futures import ThreadPoolExecutor
+        import datetime
+        import java
+        SqlDate = jpype.JClass("java.sql.Date")
+        Optional = java.util.Optional
+        time = java.time
+
+        def inc(x):
+            return x + 1
+
+        def work(offset):
+            for i in range(300):
+                k = (i + offset) % 256 - 128
+                # Boxing through the small value cache and reused proxies
+                if Optional.of(k).map(inc).get() != k + 1:
+                    return False
+                # A fresh callable each time adds and removes proxies
+                if Optional.of(k).map(lambda x: x * 2).get() != 2 * k:
+                    return False
+                # Class hints convert Python dates
+                day = 1 + i % 28
+                if jpype.JObject(datetime.date(2020, 1, day), SqlDate).toLocalDate().getDayOfMonth() != day:
+                    return False
+                # Date types share the offset cache
+                hours = k % 13
+                odt = time.OffsetDateTime.of(2021, 1, 1, 0, 0, 0, 0, time.ZoneOffset.ofHours(hours))
+                if odt._py().utcoffset() != datetime.timedelta(hours=hours):
+                    return False
+            return True
+        with ThreadPoolExecutor(8) as pool:
+            self.assertTrue(all(pool.map(work, range(8))))
+
+    def testPolicy(self):
+        old = _jpype.setThreadPolicy(False, False)
+        try:
+            self.assertEqual(_jpype.setThreadPolicy(True, True), (False, False))
+            self.assertEqual(_jpype.setThreadPolicy(True), (True, True))
+        finally:
+            _jpype.setThreadPolicy(*old)
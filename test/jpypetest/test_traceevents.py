@@ -0,0 +1,108 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+import common
+import json
+import os
+import tempfile
+import threading
+
+
+class TraceEventsTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        _jpype.clearTraceEvents()
+        fd, self.filename = tempfile.mkstemp(suffix=".json")
+        os.close(fd)
+
+    def tearDown(self):
+        _jpype.enableTraceEvents(False)
+        _jpype.clearTraceEvents()
+        os.remove(self.filename)
+
+    def load(self):
+        _jpype.dumpTraceEvents(self.filename)
+        with open(self.filename) as fd:
+            return json.load(fd)["traceEvents"]
+
+    def testEnable(self):
+        self.assertFalse(_jpype.enableTraceEvents(True))
+        self.assertTrue(_jpype.enableTraceEvents(False))
+
+    def testDisabled(self):
+        jpype.java.lang.Math.abs(-1)
+        events = [i for i in self.load() if i["ph"] != "M"]
+        self.assertEqual(events, [])
+
+    def testScopes(self):
+        Math = jpype.JClass("java.lang.Math")
+        _jpype.enableTraceEvents(True)
+        Math.abs(-1)
+        _jpype.enableTraceEvents(False)
+        events = self.load()
+        names = set(i["name"] for i in events)
+        self.assertIn("PyJPMethod_call", names)
+        self.assertIn("java", names)
+        begins = [i for i in events if i["ph"] == "B"]
+        ends = [i for i in events if i["ph"] == "E"]
+        self.assertEqual(len(begins), len(ends))
+        for event in begins + ends:
+            self.assertIn("ts", event)
+            self.assertIn("tid", event)
+
+    def testThreads(self):
+        Math = jpype.JClass("java.lang.Math")
+        _jpype.enableTraceEvents(True)
+
+        def work():
+            Math.abs(-1)
+        threads = [threading.Thread(target=work) for i in range(3)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        _jpype.enableTraceEvents(False)
+        tids = set(i["tid"] for i in self.load() if i["name"] == "PyJPMethod_call")
+        self.assertEqual(len(tids), 3)
+
+    def testProxy(self):
+        @jpype.JImplements("java.lang.Runnable")
+        class MyRunnable(object):
+            @jpype.JOverride
+            def run(self):
+                pass
+        r = jpype.JObject(MyRunnable(), "java.lang.Runnable")
+        _jpype.enableTraceEvents(True)
+        r.run()
+        _jpype.enableTraceEvents(False)
+        names = set(i["name"] for i in self.load())
+        self.assertIn("python", names)
+
+    def testClear(self):
+        _jpype.enableTraceEvents(True)
+        jpype.java.lang.Math.abs(-1)
+        _jpype.enableTraceEvents(False)
+        _jpype.clearTraceEvents()
+        events = [i for i in self.load() if i["ph"] != "M"]
+        self.assertEqual(events, [])
+
+    def testBadFile(self):
+        with self.assertRaises(OSError):
+            _jpype.dumpTraceEvents(os.path.join(self.filename, "nonexistent", "x.json"))
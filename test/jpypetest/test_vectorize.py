@@ -0,0 +1,111 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+import jpype
+from jpype import JDouble, JInt, JLong, JChar, JString
+import common
+
+try:
+    import numpy as np
+except ImportError:
+    pass
+
+
+class VectorizeTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.Math = jpype.JClass("java.lang.Math")
+
+    def testUnary(self):
+        sqrt = self.Math.sqrt.bind(JDouble)
+        out = sqrt.vectorize([1.0, 4.0, 9.0])
+        self.assertIsInstance(out, jpype.JArray(JDouble))
+        self.assertEqual(list(out), [1.0, 2.0, 3.0])
+
+    def testBinary(self):
+        mx = self.Math.max.bind(JInt, JInt)
+        self.assertEqual(list(mx.vectorize([1, 5, 3], [4, 2, 6])), [4, 5, 6])
+        mx = self.Math.max.bind(JLong, JLong)
+        self.assertEqual(list(mx.vectorize([1, 5, 3], [4, 2, 6])), [4, 5, 6])
+
+    def testBroadcast(self):
+        mx = self.Math.max.bind(JDouble, JDouble)
+        self.assertEqual(list(mx.vectorize([1.0, 5.0, 3.0], 2.0)), [2.0, 5.0, 3.0])
+        self.assertEqual(list(mx.vectorize([4.0], [1.0, 5.0])), [4.0, 5.0])
+        self.assertEqual(list(mx.vectorize(1.0, 2.0)), [2.0])
+
+    def testNonPublicClass(self):
+        Hidden = jpype.JClass("jpype.numeric.Hidden")
+        twice = Hidden.twice.bind(JDouble)
+        self.assertEqual(list(twice.vectorize([1.0, 2.5])), [2.0, 5.0])
+        # The handle is cached so a second batch must give the same answer
+        self.assertEqual(list(twice.vectorize([3.0])), [6.0])
+        scale = Hidden.scale.bind(JLong, JInt)
+        self.assertEqual(list(scale.vectorize([1, 2], 3)), [3, 6])
+
+    def testEmpty(self):
+        sqrt = self.Math.sqrt.bind(JDouble)
+        self.assertEqual(len(sqrt.vectorize([])), 0)
+
+    def testGeneric(self):
+        # Signatures without a specialized loop are boxed in Java
+        rnd = self.Math.round.bind(JDouble)
+        self.assertEqual(list(rnd.vectorize([1.2, 2.7, -0.6])), [1, 3, -1])
+        digit = jpype.JClass("java.lang.Character").isDigit.bind(JChar)
+        self.assertEqual(list(digit.vectorize("a1b2")), [False, True, False, True])
+
+    def testParallel(self):
+        add = self.Math.addExact.bind(JLong, JLong)
+        n = 100000
+        out = add.vectorize(list(range(n)), 1, parallel=True)
+        self.assertEqual(len(out), n)
+        self.assertEqual(out[0], 1)
+        self.assertEqual(out[n - 1], n)
+
+    def testException(self):
+        add = self.Math.addExact.bind(JInt, JInt)
+        with self.assertRaises(jpype.JClass("java.lang.ArithmeticException")):
+            add.vectorize([1, 2**31 - 1], 1)
+        with self.assertRaises(jpype.JClass("java.lang.ArithmeticException")):
+            add.vectorize([2**31 - 1] * 10000, 1, parallel=True)
+
+    def testFail(self):
+        sqrt = self.Math.sqrt.bind(JDouble)
+        with self.assertRaises(TypeError):
+            sqrt.vectorize([1.0], [2.0])
+        with self.assertRaises(TypeError):
+            sqrt.vectorize([1.0], other=True)
+        mx = self.Math.max.bind(JInt, JInt)
+        with self.assertRaises(ValueError):
+            mx.vectorize([1, 2], [1, 2, 3])
+        s = jpype.JClass("java.lang.String").valueOf.bind(JInt)
+        with self.assertRaisesRegex(TypeError, "primitive"):
+            s.vectorize([1, 2])
+        length = JString("abc").length.bind()
+        with self.assertRaisesRegex(TypeError, "static"):
+            length.vectorize()
+
+    @common.requireNumpy
+    def testNumpy(self):
+        x = np.linspace(0, 1, 1000)
+        out = self.Math.sqrt.bind(JDouble).vectorize(x)
+        self.assertTrue(np.allclose(np.asarray(out), np.sqrt(x)))
+        x = np.arange(1000, dtype=np.int32)
+        out = self.Math.max.bind(JInt, JInt).vectorize(x, 500)
+        self.assertTrue(np.array_equal(np.asarray(out), np.maximum(x, 500)))